@@ -16,6 +16,68 @@
 
 #include "cxoModule.h"
 
+//-----------------------------------------------------------------------------
+// cxoBuffer_fromNumber()
+//   Populate the string buffer with the text form of a number. Integers that
+// fit in 64 bits and floats (in their shortest form that round trips, the
+// same as str() returns) are formatted directly into the space within the
+// buffer so that no objects are created; all other numbers are converted
+// using str().
+//-----------------------------------------------------------------------------
+int cxoBuffer_fromNumber(cxoBuffer *buf, PyObject *obj, const char *encoding)
+{
+    char digits[CXO_BUFFER_NUMBER_SIZE], *text;
+    PyObject *textValue;
+    uint64_t magnitude;
+    long long value;
+    size_t length, i;
+    int overflow, status;
+
+    cxoBuffer_init(buf);
+    if (PyLong_Check(obj)) {
+        value = PyLong_AsLongLongAndOverflow(obj, &overflow);
+        if (value == -1 && PyErr_Occurred())
+            return -1;
+        if (!overflow) {
+            magnitude = (value < 0) ? 0 - (uint64_t) value : (uint64_t) value;
+            length = 0;
+            do {
+                digits[length++] = (char) ('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude > 0);
+            if (value < 0)
+                digits[length++] = '-';
+            for (i = 0; i < length; i++)
+                buf->number[i] = digits[length - i - 1];
+            buf->ptr = buf->number;
+            buf->size = buf->numCharacters = (uint32_t) length;
+            return 0;
+        }
+    } else if (PyFloat_Check(obj)) {
+        text = PyOS_double_to_string(PyFloat_AS_DOUBLE(obj), 'r', 0,
+                Py_DTSF_ADD_DOT_0, NULL);
+        if (!text)
+            return -1;
+        length = strlen(text);
+        if (length <= sizeof(buf->number)) {
+            memcpy(buf->number, text, length);
+            PyMem_Free(text);
+            buf->ptr = buf->number;
+            buf->size = buf->numCharacters = (uint32_t) length;
+            return 0;
+        }
+        PyMem_Free(text);
+    }
+
+    textValue = PyObject_Str(obj);
+    if (!textValue)
+        return -1;
+    status = cxoBuffer_fromObject(buf, textValue, encoding);
+    Py_DECREF(textValue);
+    return status;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoBuffer_fromObject()
 //   Populate the string buffer from a unicode object.
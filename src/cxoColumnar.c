@@ -0,0 +1,875 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoColumnar.c
+//   Routines for writing fetched rows as a set of columns in a layout that
+// can be placed in shared memory or a memory mapped file and opened by other
+// processes without copying the data.
+//
+// All integers are stored in native byte order and every section starts on an
+// 8 byte boundary so that the columns can be used directly as typed arrays.
+//
+//   header:  "CXOC", version (uint32), number of columns (uint64), number of
+//            rows (uint64)
+//   columns: for each column, the kind (uint32), the length of the name
+//            (uint32), the offsets of the null indicators, value offsets and
+//            data (uint64 each, value offsets are 0 for fixed width kinds),
+//            the length of the data (uint64), the scale of scaled integers
+//            (int32, followed by 4 reserved bytes) and the name (UTF-8,
+//            padded)
+//   data:    for each column, the null indicators (one uint8 per row, 0 for
+//            null), the value offsets (for strings and binary data only, one
+//            int64 per row plus one) and the data
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+// format identification
+#define CXO_COLUMNAR_MAGIC                  "CXOC"
+#define CXO_COLUMNAR_MAGIC_LENGTH           4
+#define CXO_COLUMNAR_VERSION                2
+#define CXO_COLUMNAR_HEADER_SIZE            24
+#define CXO_COLUMNAR_DESCRIPTOR_SIZE        48
+
+// kinds of columns
+#define CXO_COLUMNAR_KIND_INT64             1
+#define CXO_COLUMNAR_KIND_DOUBLE            2
+#define CXO_COLUMNAR_KIND_BOOLEAN           3
+#define CXO_COLUMNAR_KIND_DATETIME          4
+#define CXO_COLUMNAR_KIND_TIMEDELTA         5
+#define CXO_COLUMNAR_KIND_STRING            6
+#define CXO_COLUMNAR_KIND_BINARY            7
+#define CXO_COLUMNAR_KIND_DATETIME_S        8
+#define CXO_COLUMNAR_KIND_DATETIME_MS       9
+#define CXO_COLUMNAR_KIND_DATETIME_NS       10
+
+// round a length up to the next 8 byte boundary
+#define CXO_COLUMNAR_ALIGN(length)          (((length) + 7) & ~((size_t) 7))
+
+//-----------------------------------------------------------------------------
+// functions for the Python type "ColumnData"
+//-----------------------------------------------------------------------------
+static void cxoColumnData_free(cxoColumnData*);
+
+//-----------------------------------------------------------------------------
+// declaration of members for Python type "ColumnData"
+//-----------------------------------------------------------------------------
+static PyMemberDef cxoColumnDataMembers[] = {
+    { "name", T_OBJECT, offsetof(cxoColumnData, name), READONLY },
+    { "kind", T_OBJECT, offsetof(cxoColumnData, kind), READONLY },
+    { "data", T_OBJECT, offsetof(cxoColumnData, data), READONLY },
+    { "nulls", T_OBJECT, offsetof(cxoColumnData, nulls), READONLY },
+    { "offsets", T_OBJECT, offsetof(cxoColumnData, offsets), READONLY },
+    { "scale", T_INT, offsetof(cxoColumnData, scale), READONLY },
+    { NULL }
+};
+
+//-----------------------------------------------------------------------------
+// Python type declaration
+//-----------------------------------------------------------------------------
+PyTypeObject cxoPyTypeColumnData = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cx_Oracle.ColumnData",
+    .tp_basicsize = sizeof(cxoColumnData),
+    .tp_dealloc = (destructor) cxoColumnData_free,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_members = cxoColumnDataMembers
+};
+
+// growable buffer used for each section of a column while rows are written
+typedef struct {
+    char *ptr;
+    size_t length;
+    size_t allocated;
+} cxoColumnarBuffer;
+
+// information about each column while rows are written
+typedef struct {
+    PyObject *name;
+    cxoVar *var;
+    uint32_t kind;
+    cxoColumnarBuffer nulls;
+    cxoColumnarBuffer offsets;
+    cxoColumnarBuffer data;
+} cxoColumnarColumn;
+
+struct cxoColumnarWriter {
+    uint32_t numColumns;
+    uint64_t numRows;
+    int convertStrings;
+    cxoColumnarColumn *columns;
+};
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_append()
+//   Append the given bytes to the buffer, growing it if necessary.
+//-----------------------------------------------------------------------------
+static int cxoColumnar_append(cxoColumnarBuffer *buf, const void *ptr,
+        size_t length)
+{
+    size_t allocated;
+    char *newPtr;
+
+    if (buf->length + length > buf->allocated) {
+        allocated = (buf->allocated) ? buf->allocated : 1024;
+        while (allocated < buf->length + length)
+            allocated *= 2;
+        newPtr = PyMem_Realloc(buf->ptr, allocated);
+        if (!newPtr) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        buf->ptr = newPtr;
+        buf->allocated = allocated;
+    }
+    memcpy(buf->ptr + buf->length, ptr, length);
+    buf->length += length;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_getKind()
+//   Return the kind of column used for the values of the given variable.
+// Values which require the connection to be converted (or which have an
+// output converter) cannot be written and an exception is raised.
+//-----------------------------------------------------------------------------
+static int cxoColumnar_getKind(cxoVar *var, uint32_t pos, uint32_t *kind)
+{
+    char message[120];
+
+    if (var->outConverter && var->outConverter != Py_None) {
+        snprintf(message, sizeof(message),
+                "column %u has an output converter and cannot be shared",
+                pos);
+        cxoError_raiseFromString(cxoNotSupportedErrorException, message);
+        return -1;
+    }
+    switch (var->transformNum) {
+        case CXO_TRANSFORM_INT:
+        case CXO_TRANSFORM_NATIVE_INT:
+        case CXO_TRANSFORM_SCALED_INT:
+            *kind = CXO_COLUMNAR_KIND_INT64;
+            break;
+        case CXO_TRANSFORM_FLOAT:
+        case CXO_TRANSFORM_NATIVE_DOUBLE:
+        case CXO_TRANSFORM_NATIVE_FLOAT:
+            *kind = CXO_COLUMNAR_KIND_DOUBLE;
+            break;
+        case CXO_TRANSFORM_BOOLEAN:
+            *kind = CXO_COLUMNAR_KIND_BOOLEAN;
+            break;
+        case CXO_TRANSFORM_DATE:
+        case CXO_TRANSFORM_DATETIME:
+        case CXO_TRANSFORM_TIMESTAMP:
+        case CXO_TRANSFORM_TIMESTAMP_LTZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ_AWARE:
+        case CXO_TRANSFORM_EPOCH_US:
+            *kind = CXO_COLUMNAR_KIND_DATETIME;
+            break;
+        case CXO_TRANSFORM_EPOCH_S:
+            *kind = CXO_COLUMNAR_KIND_DATETIME_S;
+            break;
+        case CXO_TRANSFORM_EPOCH_MS:
+            *kind = CXO_COLUMNAR_KIND_DATETIME_MS;
+            break;
+        case CXO_TRANSFORM_EPOCH_NS:
+            *kind = CXO_COLUMNAR_KIND_DATETIME_NS;
+            break;
+        case CXO_TRANSFORM_TIMEDELTA:
+            *kind = CXO_COLUMNAR_KIND_TIMEDELTA;
+            break;
+        case CXO_TRANSFORM_DECIMAL:
+        case CXO_TRANSFORM_FIXED_CHAR:
+        case CXO_TRANSFORM_FIXED_NCHAR:
+        case CXO_TRANSFORM_LONG_STRING:
+        case CXO_TRANSFORM_NSTRING:
+        case CXO_TRANSFORM_ROWID:
+        case CXO_TRANSFORM_STRING:
+            *kind = CXO_COLUMNAR_KIND_STRING;
+            break;
+        case CXO_TRANSFORM_BINARY:
+        case CXO_TRANSFORM_LONG_BINARY:
+            *kind = CXO_COLUMNAR_KIND_BINARY;
+            break;
+        default:
+            snprintf(message, sizeof(message),
+                    "column %u is of type %s and cannot be shared", pos,
+                    var->dbType->name);
+            cxoError_raiseFromString(cxoNotSupportedErrorException, message);
+            return -1;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_freeWriter()
+//   Free the memory associated with the writer.
+//-----------------------------------------------------------------------------
+void cxoColumnar_freeWriter(cxoColumnarWriter *writer)
+{
+    cxoColumnarColumn *column;
+    uint32_t i;
+
+    if (writer->columns) {
+        for (i = 0; i < writer->numColumns; i++) {
+            column = &writer->columns[i];
+            Py_XDECREF(column->name);
+            if (column->nulls.ptr)
+                PyMem_Free(column->nulls.ptr);
+            if (column->offsets.ptr)
+                PyMem_Free(column->offsets.ptr);
+            if (column->data.ptr)
+                PyMem_Free(column->data.ptr);
+        }
+        PyMem_Free(writer->columns);
+    }
+    PyMem_Free(writer);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_newWriter()
+//   Create a writer for the rows fetched by the cursor, using the metadata
+// determined when the fetch variables were defined.
+//-----------------------------------------------------------------------------
+cxoColumnarWriter *cxoColumnar_newWriter(cxoCursor *cursor)
+{
+    dpiOracleTypeNum oracleTypeNum;
+    dpiNativeTypeNum nativeTypeNum;
+    cxoColumnarColumn *column;
+    cxoColumnarWriter *writer;
+    dpiQueryInfo queryInfo;
+    const char *encoding;
+    int64_t zero = 0;
+    uint32_t i;
+
+    encoding = cursor->connection->encodingInfo.encoding;
+    writer = PyMem_Malloc(sizeof(cxoColumnarWriter));
+    if (!writer) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    writer->numColumns = (uint32_t) PyList_GET_SIZE(cursor->fetchVariables);
+    writer->numRows = 0;
+    writer->convertStrings = (strcmp(encoding, "UTF-8") != 0 ||
+            strcmp(cursor->connection->encodingInfo.nencoding, "UTF-8") != 0);
+    writer->columns = PyMem_Calloc(writer->numColumns + 1,
+            sizeof(cxoColumnarColumn));
+    if (!writer->columns) {
+        PyMem_Free(writer);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for (i = 0; i < writer->numColumns; i++) {
+        column = &writer->columns[i];
+        column->var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i);
+        if (cxoColumnar_getKind(column->var, i + 1, &column->kind) < 0) {
+            cxoColumnar_freeWriter(writer);
+            return NULL;
+        }
+        if (dpiStmt_getQueryInfo(cursor->handle, i + 1, &queryInfo) < 0) {
+            cxoError_raiseAndReturnNull();
+            cxoColumnar_freeWriter(writer);
+            return NULL;
+        }
+        // unconstrained numbers may contain fractional values as well
+        if (column->var->transformNum == CXO_TRANSFORM_INT &&
+                queryInfo.typeInfo.oracleTypeNum == DPI_ORACLE_TYPE_NUMBER &&
+                queryInfo.typeInfo.precision == 0 &&
+                queryInfo.typeInfo.scale == -127)
+            column->kind = CXO_COLUMNAR_KIND_DOUBLE;
+
+        // numbers retrieved as text are parsed directly, which requires an
+        // encoding that is ASCII compatible
+        cxoTransform_getTypeInfo(column->var->transformNum, &oracleTypeNum,
+                &nativeTypeNum);
+        if ((column->kind == CXO_COLUMNAR_KIND_INT64 ||
+                column->kind == CXO_COLUMNAR_KIND_DOUBLE) &&
+                nativeTypeNum == DPI_NATIVE_TYPE_BYTES &&
+                !cxoUtils_isAsciiCompatible(encoding)) {
+            cxoError_raiseFromString(cxoNotSupportedErrorException,
+                    "numbers cannot be fetched in columnar form when the "
+                    "connection encoding is UTF-16");
+            cxoColumnar_freeWriter(writer);
+            return NULL;
+        }
+        column->name = PyUnicode_Decode(queryInfo.name, queryInfo.nameLength,
+                encoding, NULL);
+        if (!column->name) {
+            cxoColumnar_freeWriter(writer);
+            return NULL;
+        }
+        if ((column->kind == CXO_COLUMNAR_KIND_STRING ||
+                column->kind == CXO_COLUMNAR_KIND_BINARY) &&
+                cxoColumnar_append(&column->offsets, &zero,
+                        sizeof(zero)) < 0) {
+            cxoColumnar_freeWriter(writer);
+            return NULL;
+        }
+    }
+
+    return writer;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_parseInt()
+//   Parse the text of a number as a 64-bit integer. Returns 0 if the text is
+// not an integer or does not fit.
+//-----------------------------------------------------------------------------
+static int cxoColumnar_parseInt(dpiBytes *bytes, int64_t *value)
+{
+    uint64_t result = 0, limit = INT64_MAX;
+    uint32_t i = 0;
+    int negative;
+
+    negative = (bytes->length > 0 && bytes->ptr[0] == '-');
+    if (negative) {
+        i++;
+        limit++;
+    }
+    if (i == bytes->length)
+        return 0;
+    for (; i < bytes->length; i++) {
+        if (bytes->ptr[i] < '0' || bytes->ptr[i] > '9')
+            return 0;
+        if (result > (limit - (uint64_t) (bytes->ptr[i] - '0')) / 10)
+            return 0;
+        result = result * 10 + (uint64_t) (bytes->ptr[i] - '0');
+    }
+    *value = (negative) ? (int64_t) (0 - result) : (int64_t) result;
+    return 1;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_parseDouble()
+//   Parse the text of a number as a double.
+//-----------------------------------------------------------------------------
+static int cxoColumnar_parseDouble(dpiBytes *bytes, double *value)
+{
+    char buffer[200];
+
+    if (bytes->length >= sizeof(buffer)) {
+        cxoError_raiseFromString(cxoDataErrorException,
+                "number is too long to be converted");
+        return -1;
+    }
+    memcpy(buffer, bytes->ptr, bytes->length);
+    buffer[bytes->length] = '\0';
+    *value = PyOS_string_to_double(buffer, NULL, NULL);
+    if (*value == -1.0 && PyErr_Occurred())
+        return -1;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_writeText()
+//   Write a string or binary value. Strings are converted to UTF-8 if the
+// connection uses a different encoding.
+//-----------------------------------------------------------------------------
+static int cxoColumnar_writeText(cxoColumnarWriter *writer,
+        cxoColumnarColumn *column, dpiData *data)
+{
+    const char *ptr = NULL, *rowid;
+    PyObject *temp = NULL;
+    uint32_t length = 0;
+    Py_ssize_t size;
+    int64_t offset;
+    int status;
+
+    if (!data->isNull) {
+        if (column->var->transformNum == CXO_TRANSFORM_ROWID) {
+            if (dpiRowid_getStringValue(data->value.asRowid, &rowid,
+                    &length) < 0)
+                return cxoError_raiseAndReturnInt();
+            ptr = rowid;
+        } else {
+            ptr = data->value.asBytes.ptr;
+            length = data->value.asBytes.length;
+        }
+        if (writer->convertStrings &&
+                column->kind == CXO_COLUMNAR_KIND_STRING &&
+                column->var->transformNum != CXO_TRANSFORM_ROWID) {
+            temp = PyUnicode_Decode(ptr, length,
+                    data->value.asBytes.encoding, NULL);
+            if (!temp)
+                return -1;
+            ptr = PyUnicode_AsUTF8AndSize(temp, &size);
+            if (!ptr) {
+                Py_DECREF(temp);
+                return -1;
+            }
+            length = (uint32_t) size;
+        }
+    }
+    status = cxoColumnar_append(&column->data, ptr, length);
+    Py_XDECREF(temp);
+    if (status < 0)
+        return -1;
+    offset = (int64_t) column->data.length;
+    return cxoColumnar_append(&column->offsets, &offset, sizeof(offset));
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_writeValue()
+//   Write a single value taken directly from the ODPI-C data buffer.
+//-----------------------------------------------------------------------------
+static int cxoColumnar_writeValue(cxoColumnarWriter *writer,
+        cxoColumnarColumn *column, dpiData *data)
+{
+    int64_t intValue = 0, seconds, unitsPerSecond;
+    dpiIntervalDS *intervalDS;
+    dpiTimestamp *timestamp;
+    char message[160];
+    uint8_t indicator;
+    double value = 0;
+
+    indicator = !data->isNull;
+    if (cxoColumnar_append(&column->nulls, &indicator,
+            sizeof(indicator)) < 0)
+        return -1;
+    switch (column->kind) {
+        case CXO_COLUMNAR_KIND_INT64:
+            if (data->isNull) {
+                intValue = 0;
+            } else if (column->var->transformNum ==
+                    CXO_TRANSFORM_NATIVE_INT) {
+                intValue = data->value.asInt64;
+            } else if (column->var->transformNum ==
+                    CXO_TRANSFORM_SCALED_INT) {
+                if (cxoTransform_getScaledInt(&data->value.asBytes,
+                        column->var->scale, &intValue) < 0)
+                    return -1;
+            } else if (!cxoColumnar_parseInt(&data->value.asBytes,
+                    &intValue)) {
+                snprintf(message, sizeof(message),
+                        "column %u contains a value which does not fit in a "
+                        "64-bit integer; fetch it as a float or string "
+                        "instead", (uint32_t) (column - writer->columns) + 1);
+                cxoError_raiseFromString(cxoDataErrorException, message);
+                return -1;
+            }
+            return cxoColumnar_append(&column->data, &intValue,
+                    sizeof(intValue));
+        case CXO_COLUMNAR_KIND_DOUBLE:
+            if (data->isNull) {
+                value = 0;
+            } else if (column->var->transformNum ==
+                    CXO_TRANSFORM_NATIVE_DOUBLE) {
+                value = data->value.asDouble;
+            } else if (column->var->transformNum ==
+                    CXO_TRANSFORM_NATIVE_FLOAT) {
+                value = data->value.asFloat;
+            } else if (column->var->transformNum ==
+                    CXO_TRANSFORM_NATIVE_INT) {
+                value = (double) data->value.asInt64;
+            } else if (cxoColumnar_parseDouble(&data->value.asBytes,
+                    &value) < 0) {
+                return -1;
+            }
+            return cxoColumnar_append(&column->data, &value, sizeof(value));
+        case CXO_COLUMNAR_KIND_BOOLEAN:
+            indicator = (!data->isNull && data->value.asBoolean);
+            return cxoColumnar_append(&column->data, &indicator,
+                    sizeof(indicator));
+        case CXO_COLUMNAR_KIND_DATETIME:
+        case CXO_COLUMNAR_KIND_DATETIME_S:
+        case CXO_COLUMNAR_KIND_DATETIME_MS:
+        case CXO_COLUMNAR_KIND_DATETIME_NS:
+            if (!data->isNull) {
+                timestamp = &data->value.asTimestamp;
+                unitsPerSecond = cxoTransform_getEpochUnitsPerSecond(
+                        column->var->transformNum);
+                if (cxoUtils_getEpochTime(timestamp,
+                        (unitsPerSecond) ? unitsPerSecond : 1000000,
+                        (unitsPerSecond || column->var->transformNum ==
+                                CXO_TRANSFORM_TIMESTAMP_TZ_AWARE),
+                        &intValue) < 0)
+                    return -1;
+            }
+            return cxoColumnar_append(&column->data, &intValue,
+                    sizeof(intValue));
+        case CXO_COLUMNAR_KIND_TIMEDELTA:
+            if (!data->isNull) {
+                intervalDS = &data->value.asIntervalDS;
+                seconds = (int64_t) intervalDS->days * 86400 +
+                        intervalDS->hours * 3600 + intervalDS->minutes * 60 +
+                        intervalDS->seconds;
+                intValue = seconds * 1000000 + intervalDS->fseconds / 1000;
+            }
+            return cxoColumnar_append(&column->data, &intValue,
+                    sizeof(intValue));
+        default:
+            break;
+    }
+    return cxoColumnar_writeText(writer, column, data);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_writeRow()
+//   Write the row found at the given position in the fetch buffers of the
+// cursor. The fetch variables are looked up again for each row since they may
+// be replaced while fetching (when adaptive fetching grows a column).
+//-----------------------------------------------------------------------------
+int cxoColumnar_writeRow(cxoColumnarWriter *writer, cxoCursor *cursor,
+        uint32_t pos)
+{
+    cxoColumnarColumn *column;
+    uint32_t i;
+
+    for (i = 0; i < writer->numColumns; i++) {
+        column = &writer->columns[i];
+        column->var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i);
+        if (cxoColumnar_writeValue(writer, column,
+                &column->var->data[pos]) < 0)
+            return -1;
+    }
+    writer->numRows++;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_copySection()
+//   Copy a section into the output at the given offset and return the offset
+// at which the next section starts.
+//-----------------------------------------------------------------------------
+static size_t cxoColumnar_copySection(char *output, size_t offset,
+        const void *ptr, size_t length)
+{
+    if (length > 0)
+        memcpy(output + offset, ptr, length);
+    return offset + CXO_COLUMNAR_ALIGN(length);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_finish()
+//   Lay out the columns that have been written and return them as a bytes
+// object. The writer is freed in all cases.
+//-----------------------------------------------------------------------------
+PyObject *cxoColumnar_finish(cxoColumnarWriter *writer)
+{
+    uint64_t descriptor[4], numColumns;
+    size_t size, offset, dataOffset;
+    cxoColumnarColumn *column;
+    Py_ssize_t nameLength;
+    uint32_t i, temp[2];
+    int32_t scale;
+    const char *name;
+    PyObject *result;
+    char *output;
+
+    // determine the size of the output
+    size = CXO_COLUMNAR_HEADER_SIZE;
+    for (i = 0; i < writer->numColumns; i++) {
+        column = &writer->columns[i];
+        if (!PyUnicode_AsUTF8AndSize(column->name, &nameLength)) {
+            cxoColumnar_freeWriter(writer);
+            return NULL;
+        }
+        size += CXO_COLUMNAR_DESCRIPTOR_SIZE +
+                CXO_COLUMNAR_ALIGN((size_t) nameLength) +
+                CXO_COLUMNAR_ALIGN(column->nulls.length) +
+                CXO_COLUMNAR_ALIGN(column->offsets.length) +
+                CXO_COLUMNAR_ALIGN(column->data.length);
+    }
+    result = PyBytes_FromStringAndSize(NULL, (Py_ssize_t) size);
+    if (!result) {
+        cxoColumnar_freeWriter(writer);
+        return NULL;
+    }
+    output = PyBytes_AS_STRING(result);
+    memset(output, 0, size);
+
+    // write the header
+    memcpy(output, CXO_COLUMNAR_MAGIC, CXO_COLUMNAR_MAGIC_LENGTH);
+    temp[0] = CXO_COLUMNAR_VERSION;
+    memcpy(output + 4, &temp[0], sizeof(uint32_t));
+    numColumns = writer->numColumns;
+    memcpy(output + 8, &numColumns, sizeof(uint64_t));
+    memcpy(output + 16, &writer->numRows, sizeof(uint64_t));
+
+    // determine where the data for the first column starts
+    dataOffset = CXO_COLUMNAR_HEADER_SIZE;
+    for (i = 0; i < writer->numColumns; i++) {
+        PyUnicode_AsUTF8AndSize(writer->columns[i].name, &nameLength);
+        dataOffset += CXO_COLUMNAR_DESCRIPTOR_SIZE +
+                CXO_COLUMNAR_ALIGN((size_t) nameLength);
+    }
+
+    // write the descriptor and data for each column
+    offset = CXO_COLUMNAR_HEADER_SIZE;
+    for (i = 0; i < writer->numColumns; i++) {
+        column = &writer->columns[i];
+        name = PyUnicode_AsUTF8AndSize(column->name, &nameLength);
+        temp[0] = column->kind;
+        temp[1] = (uint32_t) nameLength;
+        descriptor[0] = dataOffset;
+        dataOffset = cxoColumnar_copySection(output, dataOffset,
+                column->nulls.ptr, column->nulls.length);
+        descriptor[1] = (column->offsets.length > 0) ? dataOffset : 0;
+        dataOffset = cxoColumnar_copySection(output, dataOffset,
+                column->offsets.ptr, column->offsets.length);
+        descriptor[2] = dataOffset;
+        descriptor[3] = column->data.length;
+        dataOffset = cxoColumnar_copySection(output, dataOffset,
+                column->data.ptr, column->data.length);
+        memcpy(output + offset, temp, sizeof(temp));
+        memcpy(output + offset + sizeof(temp), descriptor,
+                sizeof(descriptor));
+        scale = column->var->scale;
+        memcpy(output + offset + sizeof(temp) + sizeof(descriptor), &scale,
+                sizeof(scale));
+        offset = cxoColumnar_copySection(output,
+                offset + CXO_COLUMNAR_DESCRIPTOR_SIZE, name,
+                (size_t) nameLength);
+    }
+
+    cxoColumnar_freeWriter(writer);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_getSection()
+//   Return a memoryview of the given section of the data, cast to the given
+// format. No data is copied.
+//-----------------------------------------------------------------------------
+static PyObject *cxoColumnar_getSection(PyObject *view, uint64_t offset,
+        uint64_t length, const char *format)
+{
+    PyObject *slice, *section, *result;
+
+    slice = Py_BuildValue("(KK)", (unsigned long long) offset,
+            (unsigned long long) (offset + length));
+    if (!slice)
+        return NULL;
+    section = PySlice_New(PyTuple_GET_ITEM(slice, 0),
+            PyTuple_GET_ITEM(slice, 1), NULL);
+    Py_DECREF(slice);
+    if (!section)
+        return NULL;
+    slice = PyObject_GetItem(view, section);
+    Py_DECREF(section);
+    if (!slice)
+        return NULL;
+    result = PyObject_CallMethod(slice, "cast", "s", format);
+    Py_DECREF(slice);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnData_free()
+//   Free the memory associated with the data of a column.
+//-----------------------------------------------------------------------------
+static void cxoColumnData_free(cxoColumnData *column)
+{
+    Py_CLEAR(column->name);
+    Py_CLEAR(column->kind);
+    Py_CLEAR(column->data);
+    Py_CLEAR(column->nulls);
+    Py_CLEAR(column->offsets);
+    Py_TYPE(column)->tp_free((PyObject*) column);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_openColumn()
+//   Return an object describing the column whose descriptor is found at the
+// given offset.
+//-----------------------------------------------------------------------------
+static PyObject *cxoColumnar_openColumn(PyObject *view, Py_buffer *buffer,
+        size_t *offset, uint64_t numRows)
+{
+    static const char *kindNames[] = { NULL, "int64", "double", "boolean",
+            "datetime", "timedelta", "string", "binary", "datetime_s",
+            "datetime_ms", "datetime_ns" };
+    PyObject *name, *data, *nulls, *offsets;
+    cxoColumnData *column;
+    uint64_t descriptor[4], itemSize;
+    const char *ptr, *format;
+    uint32_t temp[2];
+    int32_t scale;
+
+    // read the descriptor
+    ptr = (const char*) buffer->buf;
+    if (*offset + CXO_COLUMNAR_DESCRIPTOR_SIZE > (size_t) buffer->len)
+        goto invalid;
+    memcpy(temp, ptr + *offset, sizeof(temp));
+    memcpy(descriptor, ptr + *offset + sizeof(temp), sizeof(descriptor));
+    memcpy(&scale, ptr + *offset + sizeof(temp) + sizeof(descriptor),
+            sizeof(scale));
+    *offset += CXO_COLUMNAR_DESCRIPTOR_SIZE;
+    if (temp[0] < CXO_COLUMNAR_KIND_INT64 ||
+            temp[0] > CXO_COLUMNAR_KIND_DATETIME_NS ||
+            *offset + temp[1] > (size_t) buffer->len)
+        goto invalid;
+    name = PyUnicode_DecodeUTF8(ptr + *offset, temp[1], NULL);
+    if (!name)
+        return NULL;
+    *offset += CXO_COLUMNAR_ALIGN((size_t) temp[1]);
+
+    // verify that the sections are all found within the data
+    switch (temp[0]) {
+        case CXO_COLUMNAR_KIND_DOUBLE:
+            format = "d";
+            itemSize = 8;
+            break;
+        case CXO_COLUMNAR_KIND_INT64:
+        case CXO_COLUMNAR_KIND_DATETIME:
+        case CXO_COLUMNAR_KIND_DATETIME_S:
+        case CXO_COLUMNAR_KIND_DATETIME_MS:
+        case CXO_COLUMNAR_KIND_DATETIME_NS:
+        case CXO_COLUMNAR_KIND_TIMEDELTA:
+            format = "q";
+            itemSize = 8;
+            break;
+        default:
+            format = "B";
+            itemSize = (temp[0] == CXO_COLUMNAR_KIND_BOOLEAN) ? 1 : 0;
+            break;
+    }
+    if (descriptor[0] + numRows > (uint64_t) buffer->len ||
+            descriptor[2] + descriptor[3] > (uint64_t) buffer->len ||
+            (itemSize > 0 && descriptor[3] != numRows * itemSize) ||
+            (itemSize == 0 && (descriptor[1] == 0 ||
+                    descriptor[1] + (numRows + 1) * 8 >
+                    (uint64_t) buffer->len))) {
+        Py_DECREF(name);
+        goto invalid;
+    }
+
+    // create the views of each section
+    nulls = cxoColumnar_getSection(view, descriptor[0], numRows, "B");
+    if (!nulls) {
+        Py_DECREF(name);
+        return NULL;
+    }
+    data = cxoColumnar_getSection(view, descriptor[2], descriptor[3], format);
+    if (!data) {
+        Py_DECREF(name);
+        Py_DECREF(nulls);
+        return NULL;
+    }
+    if (itemSize > 0) {
+        Py_INCREF(Py_None);
+        offsets = Py_None;
+    } else {
+        offsets = cxoColumnar_getSection(view, descriptor[1],
+                (numRows + 1) * 8, "q");
+        if (!offsets) {
+            Py_DECREF(name);
+            Py_DECREF(nulls);
+            Py_DECREF(data);
+            return NULL;
+        }
+    }
+    column = (cxoColumnData*)
+            cxoPyTypeColumnData.tp_alloc(&cxoPyTypeColumnData, 0);
+    if (!column) {
+        Py_DECREF(name);
+        Py_DECREF(nulls);
+        Py_DECREF(data);
+        Py_DECREF(offsets);
+        return NULL;
+    }
+    column->name = name;
+    column->data = data;
+    column->nulls = nulls;
+    column->offsets = offsets;
+    column->scale = (int) scale;
+    column->kind = PyUnicode_FromString(kindNames[temp[0]]);
+    if (!column->kind) {
+        Py_DECREF(column);
+        return NULL;
+    }
+    return (PyObject*) column;
+
+invalid:
+    return cxoError_raiseFromString(cxoProgrammingErrorException,
+            "columnar data is invalid or truncated");
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumnar_open()
+//   Return a list of the columns found in an object supporting the buffer
+// protocol which contains data created by Cursor.fetch_columns(). Each column
+// is returned as an object containing memoryview objects which refer directly
+// to the original data.
+//-----------------------------------------------------------------------------
+PyObject *cxoColumnar_open(PyObject *obj)
+{
+    PyObject *view, *columns, *column;
+    uint64_t numColumns, numRows, i;
+    Py_buffer *buffer;
+    uint32_t version;
+    size_t offset;
+
+    // acquire a view of the data
+    view = PyMemoryView_FromObject(obj);
+    if (!view)
+        return NULL;
+    buffer = PyMemoryView_GET_BUFFER(view);
+    if (!PyBuffer_IsContiguous(buffer, 'C') || buffer->itemsize != 1) {
+        Py_DECREF(view);
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "columnar data must be a contiguous buffer of bytes");
+    }
+
+    // verify the header
+    if (buffer->len < CXO_COLUMNAR_HEADER_SIZE ||
+            memcmp(buffer->buf, CXO_COLUMNAR_MAGIC,
+                    CXO_COLUMNAR_MAGIC_LENGTH) != 0) {
+        Py_DECREF(view);
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "data was not created by Cursor.fetch_columns()");
+    }
+    memcpy(&version, (char*) buffer->buf + 4, sizeof(version));
+    if (version != CXO_COLUMNAR_VERSION) {
+        Py_DECREF(view);
+        return cxoError_raiseFromString(cxoNotSupportedErrorException,
+                "columnar data version is not supported");
+    }
+    memcpy(&numColumns, (char*) buffer->buf + 8, sizeof(numColumns));
+    memcpy(&numRows, (char*) buffer->buf + 16, sizeof(numRows));
+    if (numColumns > (uint64_t) buffer->len ||
+            numRows > (uint64_t) buffer->len) {
+        Py_DECREF(view);
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "columnar data is invalid or truncated");
+    }
+
+    // create an object for each column
+    columns = PyList_New(0);
+    if (!columns) {
+        Py_DECREF(view);
+        return NULL;
+    }
+    offset = CXO_COLUMNAR_HEADER_SIZE;
+    for (i = 0; i < numColumns; i++) {
+        column = cxoColumnar_openColumn(view, buffer, &offset, numRows);
+        if (!column || PyList_Append(columns, column) < 0) {
+            Py_XDECREF(column);
+            Py_DECREF(columns);
+            Py_DECREF(view);
+            return NULL;
+        }
+        Py_DECREF(column);
+    }
+
+    Py_DECREF(view);
+    return columns;
+}
@@ -14,6 +14,73 @@
 
 #include "cxoModule.h"
 
+// query used by split_table() to calculate ROWID ranges from the extents of
+// the table (or of each of its partitions)
+static const char *cxoConnectionSplitTableSql =
+        "select dbms_rowid.rowid_create(1, o.data_object_id, e.lo_fno, "
+        "        e.lo_block, 0), "
+        "    dbms_rowid.rowid_create(1, o.data_object_id, e.hi_fno, "
+        "        e.hi_block, 32767) "
+        "from ("
+        "    select distinct partition_name, grp, "
+        "        first_value(relative_fno) over (partition by "
+        "            partition_name, grp order by relative_fno, block_id "
+        "            rows between unbounded preceding and unbounded "
+        "            following) lo_fno, "
+        "        first_value(block_id) over (partition by partition_name, "
+        "            grp order by relative_fno, block_id rows between "
+        "            unbounded preceding and unbounded following) lo_block, "
+        "        last_value(relative_fno) over (partition by "
+        "            partition_name, grp order by relative_fno, block_id "
+        "            rows between unbounded preceding and unbounded "
+        "            following) hi_fno, "
+        "        last_value(block_id + blocks - 1) over (partition by "
+        "            partition_name, grp order by relative_fno, block_id "
+        "            rows between unbounded preceding and unbounded "
+        "            following) hi_block "
+        "    from ("
+        "        select partition_name, relative_fno, block_id, blocks, "
+        "            trunc((sum(blocks) over (order by partition_name, "
+        "                relative_fno, block_id) - 0.01) / "
+        "                (sum(blocks) over () / :numChunks)) grp "
+        "        from dba_extents "
+        "        where owner = :owner "
+        "          and segment_name = :tableName "
+        "          and segment_type like 'TABLE%'"
+        "    )"
+        ") e, dba_objects o "
+        "where o.owner = :owner "
+        "  and o.object_name = :tableName "
+        "  and o.object_type like 'TABLE%' "
+        "  and o.data_object_id is not null "
+        "  and nvl(o.subobject_name, '-') = nvl(e.partition_name, '-') "
+        "order by e.partition_name, e.grp";
+
+// query used by split_table() when the dictionary views used by the above
+// query are not accessible
+static const char *cxoConnectionSplitTableFallbackSql =
+        "select min(rid), max(rid) "
+        "from ("
+        "    select rowid rid, ntile(:numChunks) over (order by rowid) chunk "
+        "    from \"%U\".\"%U\""
+        ") "
+        "group by chunk "
+        "order by chunk";
+
+//-----------------------------------------------------------------------------
+// class used for the futures returned by group_commit(); it is loaded from
+// the concurrent.futures module when first needed
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnectionFutureClass = NULL;
+
+//-----------------------------------------------------------------------------
+// class used for the result cache of cachedquery(); an ordered dictionary is
+// used so that the least recently used entry can be found in constant time;
+// it is loaded from the collections module when first needed
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnectionOrderedDictClass = NULL;
+
+
 //-----------------------------------------------------------------------------
 // functions for the Python type "Connection"
 //-----------------------------------------------------------------------------
@@ -23,10 +90,19 @@ static int cxoConnection_init(cxoConnection*, PyObject*, PyObject*);
 static PyObject *cxoConnection_repr(cxoConnection*);
 static PyObject *cxoConnection_close(cxoConnection*, PyObject*);
 static PyObject *cxoConnection_commit(cxoConnection*, PyObject*);
+static PyObject *cxoConnection_groupCommit(cxoConnection*, PyObject*);
+static void cxoConnection_completeGroupCommit(PyObject*, PyObject*);
+static void cxoConnection_waitForGroupCommit(cxoConnection*);
 static PyObject *cxoConnection_begin(cxoConnection*, PyObject*);
+static PyObject *cxoConnection_cachedQuery(cxoConnection*, PyObject*,
+        PyObject*);
+static PyObject *cxoConnection_clearResultCache(cxoConnection*, PyObject*);
+static void cxoConnection_resetResultCache(cxoConnection*);
 static PyObject *cxoConnection_prepare(cxoConnection*, PyObject*);
 static PyObject *cxoConnection_rollback(cxoConnection*, PyObject*);
 static PyObject *cxoConnection_newCursor(cxoConnection*, PyObject*, PyObject*);
+static PyObject *cxoConnection_newPreparedStatement(cxoConnection*, PyObject*,
+        PyObject*);
 static PyObject *cxoConnection_cancel(cxoConnection*, PyObject*);
 static PyObject *cxoConnection_getCallTimeout(cxoConnection*, void*);
 static PyObject *cxoConnection_getVersion(cxoConnection*, void*);
@@ -45,9 +121,13 @@ static PyObject *cxoConnection_newMessageProperties(cxoConnection*, PyObject*,
         PyObject*);
 static PyObject *cxoConnection_dequeue(cxoConnection*, PyObject*, PyObject*);
 static PyObject *cxoConnection_enqueue(cxoConnection*, PyObject*, PyObject*);
+static PyObject *cxoConnection_executeBatch(cxoConnection*, PyObject*,
+        PyObject*);
 static PyObject *cxoConnection_ping(cxoConnection*, PyObject*);
 static PyObject *cxoConnection_queue(cxoConnection*, PyObject*, PyObject*);
 static PyObject *cxoConnection_shutdown(cxoConnection*, PyObject*, PyObject*);
+static PyObject *cxoConnection_splitTable(cxoConnection*, PyObject*,
+        PyObject*);
 static PyObject *cxoConnection_startup(cxoConnection*, PyObject*, PyObject*);
 static PyObject *cxoConnection_subscribe(cxoConnection*, PyObject*, PyObject*);
 static PyObject *cxoConnection_unsubscribe(cxoConnection*, PyObject*,
@@ -60,6 +140,7 @@ static PyObject *cxoConnection_getEdition(cxoConnection*, void*);
 static PyObject *cxoConnection_getExternalName(cxoConnection*, void*);
 static PyObject *cxoConnection_getInternalName(cxoConnection*, void*);
 static PyObject *cxoConnection_getException(cxoConnection*, void*);
+static PyObject *cxoConnection_getResultCacheSubscr(cxoConnection*, void*);
 static int cxoConnection_setCallTimeout(cxoConnection*, PyObject*, void*);
 static int cxoConnection_setStmtCacheSize(cxoConnection*, PyObject*, void*);
 static int cxoConnection_setAction(cxoConnection*, PyObject*, void*);
@@ -70,6 +151,8 @@ static int cxoConnection_setDbOp(cxoConnection*, PyObject*, void*);
 static int cxoConnection_setExternalName(cxoConnection*, PyObject*, void*);
 static int cxoConnection_setInternalName(cxoConnection*, PyObject*, void*);
 static int cxoConnection_setModule(cxoConnection*, PyObject*, void*);
+static int cxoConnection_setResultCacheSubscr(cxoConnection*, PyObject*,
+        void*);
 
 
 //-----------------------------------------------------------------------------
@@ -78,12 +161,20 @@ static int cxoConnection_setModule(cxoConnection*, PyObject*, void*);
 static PyMethodDef cxoConnectionMethods[] = {
     { "cursor", (PyCFunction) cxoConnection_newCursor,
             METH_VARARGS | METH_KEYWORDS },
+    { "prepare_statement", (PyCFunction) cxoConnection_newPreparedStatement,
+            METH_VARARGS | METH_KEYWORDS },
     { "commit", (PyCFunction) cxoConnection_commit, METH_NOARGS },
+    { "group_commit", (PyCFunction) cxoConnection_groupCommit,
+            METH_NOARGS },
     { "rollback", (PyCFunction) cxoConnection_rollback, METH_NOARGS },
     { "begin", (PyCFunction) cxoConnection_begin, METH_VARARGS },
     { "prepare", (PyCFunction) cxoConnection_prepare, METH_NOARGS },
     { "close", (PyCFunction) cxoConnection_close, METH_NOARGS },
     { "cancel", (PyCFunction) cxoConnection_cancel, METH_NOARGS },
+    { "cachedquery", (PyCFunction) cxoConnection_cachedQuery,
+            METH_VARARGS | METH_KEYWORDS },
+    { "clearresultcache", (PyCFunction) cxoConnection_clearResultCache,
+            METH_NOARGS },
     { "__enter__", (PyCFunction) cxoConnection_contextManagerEnter,
             METH_NOARGS },
     { "__exit__", (PyCFunction) cxoConnection_contextManagerExit,
@@ -91,6 +182,8 @@ static PyMethodDef cxoConnectionMethods[] = {
     { "ping", (PyCFunction) cxoConnection_ping, METH_NOARGS },
     { "shutdown", (PyCFunction) cxoConnection_shutdown,
             METH_VARARGS | METH_KEYWORDS},
+    { "split_table", (PyCFunction) cxoConnection_splitTable,
+            METH_VARARGS | METH_KEYWORDS },
     { "startup", (PyCFunction) cxoConnection_startup,
             METH_VARARGS | METH_KEYWORDS},
     { "subscribe", (PyCFunction) cxoConnection_subscribe,
@@ -110,6 +203,8 @@ static PyMethodDef cxoConnectionMethods[] = {
             METH_VARARGS | METH_KEYWORDS },
     { "enq", (PyCFunction) cxoConnection_enqueue,
             METH_VARARGS | METH_KEYWORDS },
+    { "execute_batch", (PyCFunction) cxoConnection_executeBatch,
+            METH_VARARGS | METH_KEYWORDS },
     { "queue", (PyCFunction) cxoConnection_queue,
             METH_VARARGS | METH_KEYWORDS },
     { "createlob", (PyCFunction) cxoConnection_createLob, METH_O },
@@ -132,6 +227,14 @@ static PyMemberDef cxoConnectionMembers[] = {
             offsetof(cxoConnection, inputTypeHandler), 0 },
     { "outputtypehandler", T_OBJECT,
             offsetof(cxoConnection, outputTypeHandler), 0 },
+    { "resultcachesize", T_UINT, offsetof(cxoConnection, resultCacheSize),
+            0 },
+    { "resultcachetimeout", T_UINT,
+            offsetof(cxoConnection, resultCacheTimeout), 0 },
+    { "groupcommitwindow", T_UINT,
+            offsetof(cxoConnection, groupCommitWindow), 0 },
+    { "groupcommitsize", T_UINT, offsetof(cxoConnection, groupCommitSize),
+            0 },
     { NULL }
 };
 
@@ -156,6 +259,8 @@ static PyGetSetDef cxoConnectionCalcMembers[] = {
             0 },
     { "current_schema", (getter) cxoConnection_getCurrentSchema,
             (setter) cxoConnection_setCurrentSchema, 0, 0 },
+    { "resultcachesubscr", (getter) cxoConnection_getResultCacheSubscr,
+            (setter) cxoConnection_setResultCacheSubscr, 0, 0 },
     { "external_name", (getter) cxoConnection_getExternalName,
             (setter) cxoConnection_setExternalName, 0, 0 },
     { "internal_name", (getter) cxoConnection_getInternalName,
@@ -884,6 +989,20 @@ static void cxoConnection_free(cxoConnection *conn)
     Py_CLEAR(conn->inputTypeHandler);
     Py_CLEAR(conn->outputTypeHandler);
     Py_CLEAR(conn->tag);
+    Py_CLEAR(conn->tunedArraySizes);
+    Py_CLEAR(conn->resultCache);
+    Py_CLEAR(conn->resultCacheQueryIds);
+    Py_CLEAR(conn->resultCacheQueryKeys);
+    Py_CLEAR(conn->resultCacheSubscr);
+    Py_CLEAR(conn->groupCommitFutures);
+    if (conn->groupCommitLock) {
+        PyThread_free_lock(conn->groupCommitLock);
+        conn->groupCommitLock = NULL;
+    }
+    if (conn->groupCommitInProgressLock) {
+        PyThread_free_lock(conn->groupCommitInProgressLock);
+        conn->groupCommitInProgressLock = NULL;
+    }
     Py_TYPE(conn)->tp_free((PyObject*) conn);
 }
 
@@ -1146,6 +1265,9 @@ static PyObject *cxoConnection_close(cxoConnection *conn, PyObject *args)
 
     if (cxoConnection_isConnected(conn) < 0)
         return NULL;
+    if (cxoConnection_failGroupCommit(conn,
+            "connection closed before group commit was performed") < 0)
+        return NULL;
     if (cxoBuffer_fromObject(&tagBuffer, conn->tag,
             conn->encodingInfo.encoding) < 0)
         return NULL;
@@ -1162,6 +1284,8 @@ static PyObject *cxoConnection_close(cxoConnection *conn, PyObject *args)
     if (status < 0)
         return cxoError_raiseAndReturnNull();
     conn->handle = NULL;
+    cxoConnection_resetResultCache(conn);
+    Py_CLEAR(conn->resultCacheSubscr);
 
     Py_RETURN_NONE;
 }
@@ -1173,20 +1297,301 @@ static PyObject *cxoConnection_close(cxoConnection *conn, PyObject *args)
 //-----------------------------------------------------------------------------
 static PyObject *cxoConnection_commit(cxoConnection *conn, PyObject *args)
 {
+    PyObject *futures, *excType, *excValue, *excTraceback;
     int status;
 
     if (cxoConnection_isConnected(conn) < 0)
         return NULL;
+
+    // the commit is performed on behalf of any pending group commit requests
+    // as well, so take ownership of them once any commit in progress is done
+    cxoConnection_waitForGroupCommit(conn);
+    futures = conn->groupCommitFutures;
+    conn->groupCommitFutures = NULL;
+
     Py_BEGIN_ALLOW_THREADS
     status = dpiConn_commit(conn->handle);
     Py_END_ALLOW_THREADS
+
+    // complete the pending group commit requests, if any
     if (status < 0)
-        return cxoError_raiseAndReturnNull();
+        cxoError_raiseAndReturnNull();
+    if (futures) {
+        excType = excValue = excTraceback = NULL;
+        if (status < 0) {
+            PyErr_Fetch(&excType, &excValue, &excTraceback);
+            PyErr_NormalizeException(&excType, &excValue, &excTraceback);
+        }
+        cxoConnection_completeGroupCommit(futures, excValue);
+        Py_DECREF(futures);
+        if (status < 0)
+            PyErr_Restore(excType, excValue, excTraceback);
+    }
+    if (status < 0)
+        return NULL;
 
     Py_RETURN_NONE;
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_completeGroupCommit()
+//   Complete the futures for the given group commit requests, either with the
+// given exception or, if no exception is given, successfully. Any exception
+// raised by completing them (such as when they have been cancelled) is
+// ignored.
+//-----------------------------------------------------------------------------
+static void cxoConnection_completeGroupCommit(PyObject *futures,
+        PyObject *excValue)
+{
+    PyObject *result;
+    Py_ssize_t i;
+
+    for (i = 0; i < PyList_GET_SIZE(futures); i++) {
+        if (excValue)
+            result = PyObject_CallMethod(PyList_GET_ITEM(futures, i),
+                    "set_exception", "O", excValue);
+        else result = PyObject_CallMethod(PyList_GET_ITEM(futures, i),
+                "set_result", "O", Py_None);
+        if (!result)
+            PyErr_Clear();
+        Py_XDECREF(result);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_waitForGroupCommit()
+//   Wait for the commit being performed by the group commit thread, if any, to
+// complete. The lock is held by the thread for the duration of the commit.
+//-----------------------------------------------------------------------------
+static void cxoConnection_waitForGroupCommit(cxoConnection *conn)
+{
+    while (conn->groupCommitInProgress) {
+        Py_BEGIN_ALLOW_THREADS
+        PyThread_acquire_lock(conn->groupCommitInProgressLock, WAIT_LOCK);
+        PyThread_release_lock(conn->groupCommitInProgressLock);
+        Py_END_ALLOW_THREADS
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_failGroupCommit()
+//   Called before the transaction on the connection is rolled back or the
+// connection is closed. The futures of any pending group commit requests are
+// completed with an exception using the given message, since the work they
+// cover is about to be discarded, and the group commit thread is signalled so
+// that it stops without committing. Any commit already in progress is waited
+// for first so that its requests are completed correctly.
+//-----------------------------------------------------------------------------
+int cxoConnection_failGroupCommit(cxoConnection *conn, const char *message)
+{
+    PyObject *futures, *excType, *excValue, *excTraceback;
+
+    cxoConnection_waitForGroupCommit(conn);
+    if (!conn->groupCommitFutures)
+        return 0;
+    futures = conn->groupCommitFutures;
+    conn->groupCommitFutures = NULL;
+    cxoError_raiseFromString(cxoInterfaceErrorException, message);
+    PyErr_Fetch(&excType, &excValue, &excTraceback);
+    PyErr_NormalizeException(&excType, &excValue, &excTraceback);
+    if (!excValue) {
+        Py_DECREF(futures);
+        PyErr_Restore(excType, excValue, excTraceback);
+        return -1;
+    }
+    cxoConnection_completeGroupCommit(futures, excValue);
+    Py_XDECREF(excType);
+    Py_DECREF(excValue);
+    Py_XDECREF(excTraceback);
+    Py_DECREF(futures);
+    if (conn->groupCommitThreadActive && !conn->groupCommitWakePending) {
+        conn->groupCommitWakePending = 1;
+        PyThread_release_lock(conn->groupCommitLock);
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_groupCommitThread()
+//   Thread which performs the commits requested by group_commit(). After the
+// group commit window elapses (or the number of pending commits reaches the
+// group commit size), a single commit is performed on behalf of all of the
+// pending requests and their futures are completed. Requests made while the
+// commit is in progress are handled by the next commit. The thread stops when
+// no requests are pending (including when they have been completed by an
+// explicit commit or failed by a rollback or close) and holds a reference to
+// the connection until then.
+//-----------------------------------------------------------------------------
+static void cxoConnection_groupCommitThread(void *arg)
+{
+    PyObject *futures, *excType, *excValue, *excTraceback;
+    cxoConnection *conn = (cxoConnection*) arg;
+    PyGILState_STATE gstate;
+    dpiErrorInfo errorInfo;
+    PyLockStatus lockStatus;
+    dpiConn *handle;
+    int status;
+
+    gstate = PyGILState_Ensure();
+    while (conn->groupCommitFutures &&
+            PyList_GET_SIZE(conn->groupCommitFutures) > 0) {
+
+        // wait for the window to elapse unless signalled that enough commits
+        // are pending; the lock is acquired again afterwards so that it can
+        // be used to signal the thread the next time
+        lockStatus = PY_LOCK_FAILURE;
+        if (conn->groupCommitWindow > 0 && !conn->groupCommitWakePending) {
+            Py_BEGIN_ALLOW_THREADS
+            lockStatus = PyThread_acquire_lock_timed(conn->groupCommitLock,
+                    (PY_TIMEOUT_T) conn->groupCommitWindow * 1000, 0);
+            Py_END_ALLOW_THREADS
+        }
+        if (conn->groupCommitWakePending && lockStatus != PY_LOCK_ACQUIRED)
+            PyThread_acquire_lock(conn->groupCommitLock, NOWAIT_LOCK);
+        conn->groupCommitWakePending = 0;
+
+        // the pending requests may have been completed while waiting
+        if (!conn->groupCommitFutures)
+            continue;
+
+        // take ownership of the pending requests and commit on their behalf;
+        // the in progress lock is held during the commit so that an explicit
+        // commit, rollback or close can wait for it to complete
+        futures = conn->groupCommitFutures;
+        conn->groupCommitFutures = NULL;
+        status = cxoConnection_isConnected(conn);
+        if (status == 0) {
+            conn->groupCommitInProgress = 1;
+            handle = conn->handle;
+            dpiConn_addRef(handle);
+            Py_BEGIN_ALLOW_THREADS
+            PyThread_acquire_lock(conn->groupCommitInProgressLock, WAIT_LOCK);
+            status = dpiConn_commit(handle);
+            if (status < 0)
+                dpiContext_getError(cxoDpiContext, &errorInfo);
+            PyThread_release_lock(conn->groupCommitInProgressLock);
+            dpiConn_release(handle);
+            Py_END_ALLOW_THREADS
+            conn->groupCommitInProgress = 0;
+            if (status < 0)
+                cxoError_raiseFromInfo(&errorInfo);
+        }
+
+        // complete the futures
+        excType = excValue = excTraceback = NULL;
+        if (status < 0) {
+            PyErr_Fetch(&excType, &excValue, &excTraceback);
+            PyErr_NormalizeException(&excType, &excValue, &excTraceback);
+        }
+        cxoConnection_completeGroupCommit(futures, excValue);
+        Py_XDECREF(excType);
+        Py_XDECREF(excValue);
+        Py_XDECREF(excTraceback);
+        Py_DECREF(futures);
+
+    }
+
+    // mark the thread as stopped and release the reference to the connection
+    conn->groupCommitThreadActive = 0;
+    Py_DECREF(conn);
+    PyGILState_Release(gstate);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_groupCommit()
+//   Request a commit of the transaction on the connection which is coalesced
+// with other such requests made within the group commit window into a single
+// commit performed by a background thread. A future is returned which is
+// completed once the commit has been performed.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_groupCommit(cxoConnection *conn,
+        PyObject *args)
+{
+    PyObject *module, *future;
+    unsigned long threadId;
+
+    // make sure we are actually connected
+    if (cxoConnection_isConnected(conn) < 0)
+        return NULL;
+
+    // load the future class, if needed
+    if (!cxoConnectionFutureClass) {
+        module = PyImport_ImportModule("concurrent.futures");
+        if (!module)
+            return NULL;
+        cxoConnectionFutureClass = PyObject_GetAttrString(module, "Future");
+        Py_DECREF(module);
+        if (!cxoConnectionFutureClass)
+            return NULL;
+    }
+
+    // create the lock used to signal the thread, if needed; the lock is kept
+    // acquired except while the thread is being signalled
+    if (!conn->groupCommitLock) {
+        conn->groupCommitLock = PyThread_allocate_lock();
+        if (!conn->groupCommitLock) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        PyThread_acquire_lock(conn->groupCommitLock, WAIT_LOCK);
+    }
+
+    // create the lock held by the thread while a commit is in progress
+    if (!conn->groupCommitInProgressLock) {
+        conn->groupCommitInProgressLock = PyThread_allocate_lock();
+        if (!conn->groupCommitInProgressLock) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+    }
+
+    // add the request to the list of pending requests
+    if (!conn->groupCommitFutures) {
+        conn->groupCommitFutures = PyList_New(0);
+        if (!conn->groupCommitFutures)
+            return NULL;
+    }
+    future = PyObject_CallObject(cxoConnectionFutureClass, NULL);
+    if (!future)
+        return NULL;
+    if (PyList_Append(conn->groupCommitFutures, future) < 0) {
+        Py_DECREF(future);
+        return NULL;
+    }
+
+    // start the thread, if needed
+    if (!conn->groupCommitThreadActive) {
+        Py_INCREF(conn);
+        threadId = PyThread_start_new_thread(cxoConnection_groupCommitThread,
+                conn);
+        if (threadId == (unsigned long) -1) {
+            Py_DECREF(conn);
+            Py_DECREF(future);
+            Py_CLEAR(conn->groupCommitFutures);
+            cxoError_raiseFromString(cxoInterfaceErrorException,
+                    "unable to start group commit thread");
+            return NULL;
+        }
+        conn->groupCommitThreadActive = 1;
+    }
+
+    // signal the thread if enough requests are pending
+    if (conn->groupCommitSize > 0 && !conn->groupCommitWakePending &&
+            PyList_GET_SIZE(conn->groupCommitFutures) >=
+                    (Py_ssize_t) conn->groupCommitSize) {
+        conn->groupCommitWakePending = 1;
+        PyThread_release_lock(conn->groupCommitLock);
+    }
+
+    return future;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_begin()
 //   Begin a new transaction on the connection.
@@ -1257,6 +1662,9 @@ static PyObject *cxoConnection_rollback(cxoConnection *conn, PyObject *args)
 
     if (cxoConnection_isConnected(conn) < 0)
         return NULL;
+    if (cxoConnection_failGroupCommit(conn,
+            "transaction rolled back before group commit was performed") < 0)
+        return NULL;
     Py_BEGIN_ALLOW_THREADS
     status = dpiConn_rollback(conn->handle);
     Py_END_ALLOW_THREADS
@@ -1268,11 +1676,13 @@ static PyObject *cxoConnection_rollback(cxoConnection *conn, PyObject *args)
 
 
 //-----------------------------------------------------------------------------
-// cxoConnection_newCursor()
-//   Create a new cursor (statement) referencing the connection.
+// cxoConnection_createCursor()
+//   Create a new cursor of the given type referencing the connection. The
+// connection is passed as the first argument to the type, followed by the
+// arguments that were supplied.
 //-----------------------------------------------------------------------------
-static PyObject *cxoConnection_newCursor(cxoConnection *conn, PyObject *args,
-        PyObject *keywordArgs)
+static PyObject *cxoConnection_createCursor(cxoConnection *conn,
+        PyTypeObject *type, PyObject *args, PyObject *keywordArgs)
 {
     PyObject *createArgs, *result, *arg;
     Py_ssize_t numArgs = 0, i;
@@ -1291,13 +1701,36 @@ static PyObject *cxoConnection_newCursor(cxoConnection *conn, PyObject *args,
         Py_INCREF(arg);
         PyTuple_SET_ITEM(createArgs, i + 1, arg);
     }
-    result = PyObject_Call( (PyObject*) &cxoPyTypeCursor, createArgs,
-            keywordArgs);
+    result = PyObject_Call((PyObject*) type, createArgs, keywordArgs);
     Py_DECREF(createArgs);
     return result;
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_newCursor()
+//   Create a new cursor (statement) referencing the connection.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_newCursor(cxoConnection *conn, PyObject *args,
+        PyObject *keywordArgs)
+{
+    return cxoConnection_createCursor(conn, &cxoPyTypeCursor, args,
+            keywordArgs);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_newPreparedStatement()
+//   Create a new prepared statement referencing the connection.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_newPreparedStatement(cxoConnection *conn,
+        PyObject *args, PyObject *keywordArgs)
+{
+    return cxoConnection_createCursor(conn, &cxoPyTypePreparedStatement,
+            args, keywordArgs);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_cancel()
 //   Cause Oracle to issue an immediate (asynchronous) abort of any currently
@@ -1666,6 +2099,1096 @@ static PyObject *cxoConnection_shutdown(cxoConnection *conn, PyObject* args,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_resetResultCache()
+//   Discard all of the results in the result cache of the connection. The
+// queries registered with the subscription associated with the cache are
+// forgotten as well, since they may no longer be registered.
+//-----------------------------------------------------------------------------
+static void cxoConnection_resetResultCache(cxoConnection *conn)
+{
+    conn->resultCacheGeneration++;
+    Py_CLEAR(conn->resultCache);
+    Py_CLEAR(conn->resultCacheQueryIds);
+    Py_CLEAR(conn->resultCacheQueryKeys);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_callWithStatement()
+//   Call the named method of the given object with the statement and, if
+// specified, the parameters. This is used to execute and register the queries
+// that are cached.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_callWithStatement(PyObject *obj,
+        const char *methodName, PyObject *statement, PyObject *parameters)
+{
+    if (parameters == Py_None)
+        return PyObject_CallMethod(obj, methodName, "O", statement);
+    return PyObject_CallMethod(obj, methodName, "OO", statement, parameters);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_getResultCacheKey()
+//   Return the key used to cache the result of the given statement executed
+// with the given parameters. If the statement or parameters cannot be hashed,
+// the key is left as NULL and the result is not cached.
+//-----------------------------------------------------------------------------
+static int cxoConnection_getResultCacheKey(PyObject *statement,
+        PyObject *parameters, PyObject **key)
+{
+    PyObject *items, *values;
+
+    // build the key from the statement and a tuple of the parameter values;
+    // dictionaries are converted to a sorted tuple of their items so that the
+    // order in which the parameters were specified does not matter
+    if (parameters == Py_None) {
+        *key = PyTuple_Pack(1, statement);
+    } else {
+        if (PyDict_Check(parameters)) {
+            items = PyDict_Items(parameters);
+            if (!items)
+                return -1;
+            if (PyList_Sort(items) < 0) {
+                Py_DECREF(items);
+                return -1;
+            }
+            values = PyList_AsTuple(items);
+            Py_DECREF(items);
+        } else values = PySequence_Tuple(parameters);
+        if (!values)
+            return -1;
+        *key = PyTuple_Pack(2, statement, values);
+        Py_DECREF(values);
+    }
+    if (!*key)
+        return -1;
+
+    // values which cannot be hashed simply bypass the cache
+    if (PyObject_Hash(*key) == -1) {
+        Py_CLEAR(*key);
+        if (!PyErr_ExceptionMatches(PyExc_TypeError))
+            return -1;
+        PyErr_Clear();
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_evictCachedResult()
+//   Remove the entry with the given key from the result cache. The query id
+// recorded for the key when it was registered with the subscription is
+// forgotten as well so that the mappings do not grow without bound; the
+// query will be registered again if its result is cached again. A query
+// which was registered but whose result was not cached is handled the same
+// way.
+//-----------------------------------------------------------------------------
+static int cxoConnection_evictCachedResult(cxoConnection *conn,
+        PyObject *key)
+{
+    PyObject *queryId;
+    int status;
+
+    Py_INCREF(key);
+    status = PyObject_DelItem(conn->resultCache, key);
+    if (status < 0 && PyErr_ExceptionMatches(PyExc_KeyError)) {
+        PyErr_Clear();
+        status = 0;
+    }
+    if (status == 0 && conn->resultCacheQueryIds) {
+        queryId = PyDict_GetItemWithError(conn->resultCacheQueryIds, key);
+        if (queryId) {
+            Py_INCREF(queryId);
+            if (queryId != Py_None && conn->resultCacheQueryKeys &&
+                    PyDict_GetItemWithError(conn->resultCacheQueryKeys,
+                            queryId))
+                status = PyDict_DelItem(conn->resultCacheQueryKeys, queryId);
+            else if (PyErr_Occurred())
+                status = -1;
+            if (status == 0)
+                status = PyDict_DelItem(conn->resultCacheQueryIds, key);
+            Py_DECREF(queryId);
+        } else if (PyErr_Occurred()) {
+            status = -1;
+        }
+    }
+    Py_DECREF(key);
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_getCachedResult()
+//   Return the rows cached for the given key, if any are present and they have
+// not yet expired. Each entry in the cache is a tuple containing the rows
+// (in the compact format created by Cursor.fetch_serialized()) and the time
+// at which they expire (or 0 if they never expire). The entry is moved to the
+// end of the cache to mark it as the most recently used entry. A new list of
+// rows is created each time so that it can be modified freely.
+//-----------------------------------------------------------------------------
+static int cxoConnection_getCachedResult(cxoConnection *conn, PyObject *key,
+        double now, PyObject **rows)
+{
+    PyObject *entry, *result;
+    double expires;
+
+    // look up the entry in the cache
+    *rows = NULL;
+    if (!conn->resultCache)
+        return 0;
+    entry = PyDict_GetItemWithError(conn->resultCache, key);
+    if (!entry)
+        return (PyErr_Occurred()) ? -1 : 0;
+
+    // discard the entry if it has expired
+    expires = PyFloat_AS_DOUBLE(PyTuple_GET_ITEM(entry, 1));
+    if (expires > 0 && now >= expires)
+        return cxoConnection_evictCachedResult(conn, key);
+
+    // mark the entry as most recently used and return its rows
+    Py_INCREF(entry);
+    result = PyObject_CallMethod(conn->resultCache, "move_to_end", "O", key);
+    if (result) {
+        Py_DECREF(result);
+        *rows = cxoSerialize_load(PyTuple_GET_ITEM(entry, 0));
+    }
+    Py_DECREF(entry);
+    return (*rows) ? 0 : -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_storeCachedResult()
+//   Store the rows fetched for the given key (in the compact format created by
+// Cursor.fetch_serialized()) in the cache, discarding the least recently used
+// entries (found at the start of the cache) if the cache would exceed its
+// maximum size.
+//-----------------------------------------------------------------------------
+static int cxoConnection_storeCachedResult(cxoConnection *conn, PyObject *key,
+        PyObject *data, double now)
+{
+    PyObject *module, *entry, *iter, *oldestKey;
+    double expires;
+    int status;
+
+    // create the cache, if needed
+    if (!conn->resultCache) {
+        if (!cxoConnectionOrderedDictClass) {
+            module = PyImport_ImportModule("collections");
+            if (!module)
+                return -1;
+            cxoConnectionOrderedDictClass = PyObject_GetAttrString(module,
+                    "OrderedDict");
+            Py_DECREF(module);
+            if (!cxoConnectionOrderedDictClass)
+                return -1;
+        }
+        conn->resultCache =
+                PyObject_CallObject(cxoConnectionOrderedDictClass, NULL);
+        if (!conn->resultCache)
+            return -1;
+    }
+
+    // discard the least recently used entries until there is room for the
+    // new entry
+    while (PyObject_Length(conn->resultCache) >=
+            (Py_ssize_t) conn->resultCacheSize) {
+        iter = PyObject_GetIter(conn->resultCache);
+        if (!iter)
+            return -1;
+        oldestKey = PyIter_Next(iter);
+        Py_DECREF(iter);
+        if (!oldestKey)
+            return (PyErr_Occurred()) ? -1 : 0;
+        status = cxoConnection_evictCachedResult(conn, oldestKey);
+        Py_DECREF(oldestKey);
+        if (status < 0)
+            return -1;
+    }
+
+    // add the entry to the cache
+    expires = (conn->resultCacheTimeout > 0) ?
+            now + (double) conn->resultCacheTimeout * 1000.0 : 0;
+    entry = Py_BuildValue("(Od)", data, expires);
+    if (!entry)
+        return -1;
+    status = PyObject_SetItem(conn->resultCache, key, entry);
+    Py_DECREF(entry);
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_registerCachedQuery()
+//   Register the query with the subscription used to invalidate the result
+// cache, if this has not already been done for the given key. The query id
+// returned by the subscription is retained so that notifications can be
+// mapped back to the entry in the cache.
+//-----------------------------------------------------------------------------
+static int cxoConnection_registerCachedQuery(cxoConnection *conn,
+        PyObject *key, PyObject *statement, PyObject *parameters)
+{
+    PyObject *queryId;
+    int status;
+
+    // create the dictionaries used to map keys to query ids and back again
+    if (!conn->resultCacheQueryIds) {
+        conn->resultCacheQueryIds = PyDict_New();
+        if (!conn->resultCacheQueryIds)
+            return -1;
+    }
+    if (!conn->resultCacheQueryKeys) {
+        conn->resultCacheQueryKeys = PyDict_New();
+        if (!conn->resultCacheQueryKeys)
+            return -1;
+    }
+
+    // nothing to do if the query has already been registered
+    if (PyDict_GetItemWithError(conn->resultCacheQueryIds, key))
+        return 0;
+    if (PyErr_Occurred())
+        return -1;
+
+    // register the query; if the subscription does not return query ids, any
+    // notification received invalidates the entire cache instead
+    queryId = cxoConnection_callWithStatement(
+            (PyObject*) conn->resultCacheSubscr, "registerquery", statement,
+            parameters);
+    if (!queryId)
+        return -1;
+    status = PyDict_SetItem(conn->resultCacheQueryIds, key, queryId);
+    if (status == 0 && queryId != Py_None)
+        status = PyDict_SetItem(conn->resultCacheQueryKeys, queryId, key);
+    Py_DECREF(queryId);
+
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_cachedQuery()
+//   Execute the query and return all of its rows as a list, using the result
+// cache of the connection if it is enabled. Results are cached by statement
+// and parameter values and remain cached until they expire, are discarded to
+// make room for other results, or are invalidated by a notification received
+// by the subscription associated with the cache. Since results would
+// otherwise never be invalidated, the cache requires a timeout or a
+// subscription. The rows are cached in the compact format created by
+// Cursor.fetch_serialized(); results which cannot be serialized are not
+// cached.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_cachedQuery(cxoConnection *conn,
+        PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "statement", "parameters", NULL };
+    PyObject *statement, *parameters, *key, *cursor, *result, *rows, *data;
+    unsigned long generation;
+    double now;
+
+    // parse arguments
+    parameters = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|O", keywordList,
+            &statement, &parameters))
+        return NULL;
+
+    // make sure we are actually connected
+    if (cxoConnection_isConnected(conn) < 0)
+        return NULL;
+
+    // return the cached rows, if available
+    key = NULL;
+    now = cxoUtils_getMonotonicTime();
+    if (conn->resultCacheSize > 0) {
+        if (!conn->resultCacheSubscr && conn->resultCacheTimeout == 0)
+            return cxoError_raiseFromString(cxoProgrammingErrorException,
+                    "the result cache requires resultcachetimeout or "
+                    "resultcachesubscr to be set");
+        if (cxoConnection_getResultCacheKey(statement, parameters, &key) < 0)
+            return NULL;
+        if (key && cxoConnection_getCachedResult(conn, key, now, &rows) < 0) {
+            Py_DECREF(key);
+            return NULL;
+        }
+        if (key && rows) {
+            Py_DECREF(key);
+            return rows;
+        }
+    }
+
+    // register the query for notification before it is executed so that no
+    // changes made after the rows are fetched can be missed
+    if (key && conn->resultCacheSubscr &&
+            cxoConnection_registerCachedQuery(conn, key, statement,
+                    parameters) < 0) {
+        Py_DECREF(key);
+        return NULL;
+    }
+
+    // execute the query and fetch all of its rows; if the result is to be
+    // cached, the rows are fetched in serialized form, unless the columns
+    // cannot be serialized (which is detected before any rows are fetched)
+    generation = conn->resultCacheGeneration;
+    rows = data = NULL;
+    cursor = PyObject_CallMethod((PyObject*) conn, "cursor", NULL);
+    if (cursor) {
+        result = cxoConnection_callWithStatement(cursor, "execute", statement,
+                parameters);
+        if (result) {
+            Py_DECREF(result);
+            if (key) {
+                data = PyObject_CallMethod(cursor, "fetch_serialized", NULL);
+                if (data)
+                    rows = cxoSerialize_load(data);
+                else if (PyErr_ExceptionMatches(cxoNotSupportedErrorException))
+                    PyErr_Clear();
+            }
+            if (!data && !PyErr_Occurred())
+                rows = PyObject_CallMethod(cursor, "fetchall", NULL);
+        }
+        Py_DECREF(cursor);
+    }
+    if (!rows) {
+        Py_XDECREF(key);
+        Py_XDECREF(data);
+        return NULL;
+    }
+
+    // cache the rows, unless a notification was received while they were
+    // being fetched, in which case they may already be out of date
+    if (data && conn->resultCacheSize > 0 &&
+            generation == conn->resultCacheGeneration &&
+            cxoConnection_storeCachedResult(conn, key, data, now) < 0) {
+        Py_DECREF(key);
+        Py_DECREF(data);
+        Py_DECREF(rows);
+        return NULL;
+    }
+    Py_XDECREF(key);
+    Py_XDECREF(data);
+
+    return rows;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_clearResultCache()
+//   Discard all of the results in the result cache of the connection.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_clearResultCache(cxoConnection *conn,
+        PyObject *args)
+{
+    cxoConnection_resetResultCache(conn);
+    Py_RETURN_NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_invalidateResultCache()
+//   Invalidate the results in the result cache of the connection affected by
+// the notification received by the given subscription. If the notification
+// does not identify the queries affected, all results are discarded. The GIL
+// must be held when this function is called.
+//-----------------------------------------------------------------------------
+void cxoConnection_invalidateResultCache(cxoConnection *conn,
+        cxoSubscr *subscr, dpiSubscrMessage *message)
+{
+    PyObject *queryId, *key;
+    uint32_t i;
+
+    if (conn->resultCacheSubscr != subscr)
+        return;
+    conn->resultCacheGeneration++;
+    if (message->eventType == DPI_EVENT_QUERYCHANGE &&
+            conn->resultCache && conn->resultCacheQueryKeys) {
+        for (i = 0; i < message->numQueries; i++) {
+            queryId = PyLong_FromUnsignedLongLong(message->queries[i].id);
+            if (!queryId)
+                break;
+            key = PyDict_GetItem(conn->resultCacheQueryKeys, queryId);
+            Py_DECREF(queryId);
+            if (key && cxoConnection_evictCachedResult(conn, key) < 0)
+                PyErr_Clear();
+        }
+        PyErr_Clear();
+    } else {
+        cxoConnection_resetResultCache(conn);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_getResultCacheSubscr()
+//   Return the subscription used to invalidate the result cache.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_getResultCacheSubscr(cxoConnection *conn,
+        void *unused)
+{
+    if (!conn->resultCacheSubscr)
+        Py_RETURN_NONE;
+    Py_INCREF(conn->resultCacheSubscr);
+    return (PyObject*) conn->resultCacheSubscr;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_setResultCacheSubscr()
+//   Set the subscription used to invalidate the result cache. The cache is
+// cleared since the results it contains were not registered with the new
+// subscription.
+//-----------------------------------------------------------------------------
+static int cxoConnection_setResultCacheSubscr(cxoConnection *conn,
+        PyObject *value, void *unused)
+{
+    cxoSubscr *subscr = NULL;
+
+    if (value && value != Py_None) {
+        if (!PyObject_TypeCheck(value, &cxoPyTypeSubscr)) {
+            PyErr_SetString(PyExc_TypeError,
+                    "expecting a subscription or None");
+            return -1;
+        }
+        subscr = (cxoSubscr*) value;
+        if (subscr->connection != conn || !subscr->handle) {
+            cxoError_raiseFromString(cxoProgrammingErrorException,
+                    "subscription must be registered using this connection");
+            return -1;
+        }
+        Py_INCREF(subscr);
+    }
+    cxoConnection_resetResultCache(conn);
+    Py_XDECREF(conn->resultCacheSubscr);
+    conn->resultCacheSubscr = subscr;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_getBatchStatement()
+//   Return the statement and parameters (borrowed references) for an entry in
+// the list passed to execute_batch(). Each entry is either a string or a
+// tuple containing a string and, optionally, the parameters to bind.
+//-----------------------------------------------------------------------------
+static int cxoConnection_getBatchStatement(PyObject *entry,
+        PyObject **statement, PyObject **parameters)
+{
+    *parameters = Py_None;
+    if (PyUnicode_Check(entry)) {
+        *statement = entry;
+        return 0;
+    }
+    if (!PyTuple_Check(entry) || PyTuple_GET_SIZE(entry) < 1 ||
+            PyTuple_GET_SIZE(entry) > 2 ||
+            !PyUnicode_Check(PyTuple_GET_ITEM(entry, 0))) {
+        PyErr_SetString(PyExc_TypeError,
+                "expecting a string or a tuple of (statement, parameters)");
+        return -1;
+    }
+    *statement = PyTuple_GET_ITEM(entry, 0);
+    if (PyTuple_GET_SIZE(entry) == 2)
+        *parameters = PyTuple_GET_ITEM(entry, 1);
+    if (*parameters != Py_None && !PyDict_Check(*parameters) &&
+            (!PySequence_Check(*parameters) ||
+                    PyUnicode_Check(*parameters))) {
+        PyErr_SetString(PyExc_TypeError,
+                "parameters must be a sequence or dictionary");
+        return -1;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_isBindNameChar()
+//   Return whether the character may be part of an unquoted bind name.
+//-----------------------------------------------------------------------------
+static int cxoConnection_isBindNameChar(Py_UCS4 ch)
+{
+    return (Py_UNICODE_ISALNUM(ch) || ch == '_' || ch == '$' || ch == '#');
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_skipLiteral()
+//   Return the position following the string literal, quoted identifier or
+// comment starting at the given position, or the given position itself if
+// none starts there.
+//-----------------------------------------------------------------------------
+static Py_ssize_t cxoConnection_skipLiteral(int kind, void *data,
+        Py_ssize_t length, Py_ssize_t pos)
+{
+    Py_UCS4 ch, nextCh, closeCh;
+
+    ch = PyUnicode_READ(kind, data, pos);
+    nextCh = (pos + 1 < length) ? PyUnicode_READ(kind, data, pos + 1) : 0;
+
+    // string literals and quoted identifiers
+    if (ch == '\'' || ch == '"') {
+        for (pos++; pos < length; pos++) {
+            if (PyUnicode_READ(kind, data, pos) == ch)
+                return pos + 1;
+        }
+        return length;
+    }
+
+    // alternative quoting mechanism: q'[...]' and the like
+    if ((ch == 'q' || ch == 'Q') && nextCh == '\'' && pos + 2 < length &&
+            (pos == 0 || !cxoConnection_isBindNameChar(
+                    PyUnicode_READ(kind, data, pos - 1)) ||
+             ((PyUnicode_READ(kind, data, pos - 1) == 'n' ||
+                     PyUnicode_READ(kind, data, pos - 1) == 'N') &&
+              (pos == 1 || !cxoConnection_isBindNameChar(
+                      PyUnicode_READ(kind, data, pos - 2)))))) {
+        closeCh = PyUnicode_READ(kind, data, pos + 2);
+        switch (closeCh) {
+            case '[': closeCh = ']'; break;
+            case '{': closeCh = '}'; break;
+            case '(': closeCh = ')'; break;
+            case '<': closeCh = '>'; break;
+        }
+        for (pos += 3; pos + 1 < length; pos++) {
+            if (PyUnicode_READ(kind, data, pos) == closeCh &&
+                    PyUnicode_READ(kind, data, pos + 1) == '\'')
+                return pos + 2;
+        }
+        return length;
+    }
+
+    // single line comments
+    if (ch == '-' && nextCh == '-') {
+        for (pos += 2; pos < length; pos++) {
+            if (PyUnicode_READ(kind, data, pos) == '\n')
+                return pos + 1;
+        }
+        return length;
+    }
+
+    // multiple line comments
+    if (ch == '/' && nextCh == '*') {
+        for (pos += 2; pos + 1 < length; pos++) {
+            if (PyUnicode_READ(kind, data, pos) == '*' &&
+                    PyUnicode_READ(kind, data, pos + 1) == '/')
+                return pos + 2;
+        }
+        return length;
+    }
+
+    return pos;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_renameBinds()
+//   Rename the bind variables in the statement so that they are unique within
+// the anonymous PL/SQL block generated by execute_batch() and add their values
+// to the given dictionary. Each statement is given its own prefix; positional
+// parameters are bound to the placeholders in the order in which they occur.
+// If the statement cannot be rewritten safely (quoted bind names or missing
+// parameters), 1 is returned and the statement is left unchanged.
+//-----------------------------------------------------------------------------
+static int cxoConnection_renameBinds(PyObject *statement,
+        Py_ssize_t statementNum, PyObject *parameters, PyObject *bindVars,
+        PyObject **newStatement)
+{
+    PyObject *pieces, *piece, *name, *newName, *value, *upperParameters;
+    PyObject *key, *upperKey;
+    Py_ssize_t length, pos, start, end, numBinds, paramPos;
+    int kind, status;
+    void *data;
+
+    // when parameters are supplied by name, look them up case insensitively,
+    // as the database does
+    upperParameters = NULL;
+    if (PyDict_Check(parameters)) {
+        upperParameters = PyDict_New();
+        if (!upperParameters)
+            return -1;
+        paramPos = 0;
+        while (PyDict_Next(parameters, &paramPos, &key, &value)) {
+            if (!PyUnicode_Check(key)) {
+                Py_DECREF(upperParameters);
+                return 1;
+            }
+            upperKey = PyObject_CallMethod(key, "upper", NULL);
+            if (!upperKey || PyDict_SetItem(upperParameters, upperKey,
+                    value) < 0) {
+                Py_XDECREF(upperKey);
+                Py_DECREF(upperParameters);
+                return -1;
+            }
+            Py_DECREF(upperKey);
+        }
+    }
+
+    // scan the statement, replacing each bind variable with its new name
+    if (PyUnicode_READY(statement) < 0) {
+        Py_XDECREF(upperParameters);
+        return -1;
+    }
+    kind = PyUnicode_KIND(statement);
+    data = PyUnicode_DATA(statement);
+    length = PyUnicode_GET_LENGTH(statement);
+    pieces = PyList_New(0);
+    if (!pieces) {
+        Py_XDECREF(upperParameters);
+        return -1;
+    }
+    start = pos = numBinds = 0;
+    status = 0;
+    while (status == 0 && pos < length) {
+
+        // skip literals and comments, which may contain colons
+        end = cxoConnection_skipLiteral(kind, data, length, pos);
+        if (end != pos) {
+            pos = end;
+            continue;
+        }
+        if (PyUnicode_READ(kind, data, pos) != ':' || pos + 1 >= length) {
+            pos++;
+            continue;
+        }
+        if (PyUnicode_READ(kind, data, pos + 1) == '"') {
+            status = 1;
+            break;
+        }
+        for (end = pos + 1; end < length; end++) {
+            if (!cxoConnection_isBindNameChar(PyUnicode_READ(kind, data,
+                    end)))
+                break;
+        }
+        if (end == pos + 1) {
+            pos++;
+            continue;
+        }
+
+        // determine the new name of the bind variable and its value
+        numBinds++;
+        value = newName = NULL;
+        if (upperParameters) {
+            name = PyUnicode_Substring(statement, pos + 1, end);
+            key = (name) ? PyObject_CallMethod(name, "upper", NULL) : NULL;
+            Py_XDECREF(name);
+            if (!key) {
+                status = -1;
+                break;
+            }
+            value = PyDict_GetItem(upperParameters, key);
+            Py_XINCREF(value);
+            if (value)
+                newName = PyUnicode_FromFormat("b%zd_%U", statementNum, key);
+            Py_DECREF(key);
+        } else if (parameters != Py_None &&
+                numBinds <= PySequence_Size(parameters)) {
+            value = PySequence_GetItem(parameters, numBinds - 1);
+            if (value)
+                newName = PyUnicode_FromFormat("b%zd_%zd", statementNum,
+                        numBinds);
+        }
+        if (!value) {
+            status = (PyErr_Occurred()) ? -1 : 1;
+            break;
+        }
+        if (!newName || PyDict_SetItem(bindVars, newName, value) < 0) {
+            Py_DECREF(value);
+            Py_XDECREF(newName);
+            status = -1;
+            break;
+        }
+        Py_DECREF(value);
+
+        // add the text preceding the bind variable and its new name
+        piece = PyUnicode_Substring(statement, start, pos + 1);
+        if (!piece || PyList_Append(pieces, piece) < 0 ||
+                PyList_Append(pieces, newName) < 0)
+            status = -1;
+        Py_XDECREF(piece);
+        Py_DECREF(newName);
+        start = pos = end;
+    }
+    Py_XDECREF(upperParameters);
+
+    // all positional parameters must have been used
+    if (status == 0 && !PyDict_Check(parameters) && parameters != Py_None &&
+            numBinds != PySequence_Size(parameters))
+        status = (PyErr_Occurred()) ? -1 : 1;
+
+    // add the remaining text and join the pieces together
+    if (status == 0) {
+        piece = PyUnicode_Substring(statement, start, length);
+        if (!piece || PyList_Append(pieces, piece) < 0)
+            status = -1;
+        Py_XDECREF(piece);
+    }
+    if (status == 0) {
+        *newStatement = PyUnicode_Join(NULL, pieces);
+        if (!*newStatement)
+            status = -1;
+    }
+    Py_DECREF(pieces);
+
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_executeBatchCombined()
+//   Execute all of the statements in the batch in a single round trip by
+// generating an anonymous PL/SQL block which returns the rows of each query
+// as an implicit result and the number of rows affected by each DML statement
+// as an out bind variable. If any of the statements cannot be included in such
+// a block, 1 is returned and nothing is executed.
+//-----------------------------------------------------------------------------
+static int cxoConnection_executeBatchCombined(cxoConnection *conn,
+        cxoCursor *cursor, PyObject *statements, PyObject **results)
+{
+    PyObject *declarations, *body, *bindVars, *rowCountVars, *statement;
+    PyObject *parameters, *newStatement, *var, *temp, *block, *implicit;
+    PyObject *result;
+    Py_ssize_t i, numStatements, numQueries;
+    int status;
+
+    // create the objects used to build the block
+    numStatements = PySequence_Fast_GET_SIZE(statements);
+    declarations = PyList_New(0);
+    body = PyList_New(0);
+    bindVars = PyDict_New();
+    rowCountVars = PyList_New(numStatements);
+    if (!declarations || !body || !bindVars || !rowCountVars) {
+        Py_XDECREF(declarations);
+        Py_XDECREF(body);
+        Py_XDECREF(bindVars);
+        Py_XDECREF(rowCountVars);
+        return -1;
+    }
+
+    // add each statement to the block; the statements are prepared (which
+    // does not require a round trip) in order to determine their type
+    status = 0;
+    numQueries = 0;
+    for (i = 0; status == 0 && i < numStatements; i++) {
+        if (cxoConnection_getBatchStatement(
+                PySequence_Fast_GET_ITEM(statements, i), &statement,
+                &parameters) < 0) {
+            status = -1;
+            break;
+        }
+        temp = PyObject_CallMethod((PyObject*) cursor, "prepare", "O",
+                statement);
+        if (!temp) {
+            status = -1;
+            break;
+        }
+        Py_DECREF(temp);
+        if ((!cursor->stmtInfo.isQuery && !cursor->stmtInfo.isDML) ||
+                cursor->stmtInfo.isReturning) {
+            status = 1;
+            break;
+        }
+        status = cxoConnection_renameBinds(statement, i + 1, parameters,
+                bindVars, &newStatement);
+        if (status != 0)
+            break;
+        var = NULL;
+        if (cursor->stmtInfo.isQuery) {
+            numQueries++;
+            Py_INCREF(Py_None);
+            PyList_SET_ITEM(rowCountVars, i, Py_None);
+            temp = PyUnicode_FromFormat("    c%zd sys_refcursor;\n", i + 1);
+            if (!temp || PyList_Append(declarations, temp) < 0)
+                status = -1;
+            Py_XDECREF(temp);
+            temp = PyUnicode_FromFormat("    open c%zd for %U;\n"
+                    "    dbms_sql.return_result(c%zd);\n", i + 1,
+                    newStatement, i + 1);
+        } else {
+            var = PyObject_CallMethod((PyObject*) cursor, "var", "O",
+                    &PyLong_Type);
+            if (!var)
+                status = -1;
+            else {
+                PyList_SET_ITEM(rowCountVars, i, var);
+                temp = PyUnicode_FromFormat("r%zd", i + 1);
+                if (!temp || PyDict_SetItem(bindVars, temp, var) < 0)
+                    status = -1;
+                Py_XDECREF(temp);
+            }
+            temp = PyUnicode_FromFormat("    %U;\n"
+                    "    :r%zd := sql%%rowcount;\n", newStatement, i + 1);
+        }
+        Py_DECREF(newStatement);
+        if (!temp || PyList_Append(body, temp) < 0)
+            status = -1;
+        Py_XDECREF(temp);
+    }
+
+    // execute the block
+    block = NULL;
+    if (status == 0) {
+        temp = PyUnicode_Join(NULL, declarations);
+        var = PyUnicode_Join(NULL, body);
+        if (temp && var)
+            block = PyUnicode_FromFormat("declare\n%Ubegin\n%Uend;", temp,
+                    var);
+        Py_XDECREF(temp);
+        Py_XDECREF(var);
+        if (!block)
+            status = -1;
+    }
+    Py_DECREF(declarations);
+    Py_DECREF(body);
+    if (status == 0) {
+        temp = PyObject_CallMethod((PyObject*) cursor, "execute", "OO",
+                block, bindVars);
+        if (!temp)
+            status = -1;
+        Py_XDECREF(temp);
+    }
+    Py_XDECREF(block);
+    Py_DECREF(bindVars);
+
+    // gather the results: the rows of each query and the number of rows
+    // affected by each DML statement
+    implicit = NULL;
+    if (status == 0 && numQueries > 0) {
+        implicit = PyObject_CallMethod((PyObject*) cursor,
+                "getimplicitresults", NULL);
+        if (!implicit)
+            status = -1;
+    }
+    if (status == 0) {
+        *results = PyList_New(numStatements);
+        if (!*results)
+            status = -1;
+    }
+    for (i = 0, numQueries = 0; status == 0 && i < numStatements; i++) {
+        var = PyList_GET_ITEM(rowCountVars, i);
+        if (var == Py_None)
+            result = PyObject_CallMethod(PyList_GET_ITEM(implicit,
+                    numQueries++), "fetchall", NULL);
+        else result = PyObject_CallMethod(var, "getvalue", NULL);
+        if (!result) {
+            Py_CLEAR(*results);
+            status = -1;
+            break;
+        }
+        PyList_SET_ITEM(*results, i, result);
+    }
+    Py_XDECREF(implicit);
+    Py_DECREF(rowCountVars);
+
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_executeBatchSequentially()
+//   Execute each of the statements in the batch in turn, returning the rows
+// of each query and the number of rows affected by each other statement.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_executeBatchSequentially(cxoConnection *conn,
+        cxoCursor *cursor, PyObject *statements)
+{
+    PyObject *results, *result, *statement, *parameters;
+    Py_ssize_t i, numStatements;
+
+    numStatements = PySequence_Fast_GET_SIZE(statements);
+    results = PyList_New(numStatements);
+    if (!results)
+        return NULL;
+    for (i = 0; i < numStatements; i++) {
+        if (cxoConnection_getBatchStatement(
+                PySequence_Fast_GET_ITEM(statements, i), &statement,
+                &parameters) < 0) {
+            Py_DECREF(results);
+            return NULL;
+        }
+        result = cxoConnection_callWithStatement((PyObject*) cursor,
+                "execute", statement, parameters);
+        if (result && result != Py_None) {
+            Py_DECREF(result);
+            result = PyObject_CallMethod((PyObject*) cursor, "fetchall",
+                    NULL);
+        } else if (result) {
+            Py_DECREF(result);
+            result = PyLong_FromUnsignedLongLong(cursor->rowCount);
+        }
+        if (!result) {
+            Py_DECREF(results);
+            return NULL;
+        }
+        PyList_SET_ITEM(results, i, result);
+    }
+
+    return results;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_executeBatch()
+//   Execute a batch of independent statements and return a list containing
+// the rows of each query and the number of rows affected by each other
+// statement. When all of the statements are queries or DML statements and
+// the client and database support implicit results, the statements are
+// executed in a single round trip; otherwise, they are executed one after the
+// other.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_executeBatch(cxoConnection *conn,
+        PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "statements", NULL };
+    PyObject *statementsObj, *statements, *results;
+    dpiVersionInfo versionInfo;
+    cxoCursor *cursor;
+    int status;
+
+    // parse arguments
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O", keywordList,
+            &statementsObj))
+        return NULL;
+    statements = PySequence_Fast(statementsObj,
+            "expecting a sequence of statements");
+    if (!statements)
+        return NULL;
+
+    // make sure we are actually connected
+    if (cxoConnection_isConnected(conn) < 0) {
+        Py_DECREF(statements);
+        return NULL;
+    }
+
+    // implicit results require Oracle Client and Database 12.1 or higher
+    status = 1;
+    if (PySequence_Fast_GET_SIZE(statements) > 1 &&
+            cxoClientVersionInfo.versionNum >= 12) {
+        Py_BEGIN_ALLOW_THREADS
+        status = dpiConn_getServerVersion(conn->handle, NULL, NULL,
+                &versionInfo);
+        Py_END_ALLOW_THREADS
+        if (status < 0) {
+            Py_DECREF(statements);
+            return cxoError_raiseAndReturnNull();
+        }
+        status = (versionInfo.versionNum >= 12) ? 0 : 1;
+    }
+
+    // execute the statements
+    cursor = (cxoCursor*) PyObject_CallMethod((PyObject*) conn, "cursor",
+            NULL);
+    if (!cursor) {
+        Py_DECREF(statements);
+        return NULL;
+    }
+    results = NULL;
+    if (status == 0)
+        status = cxoConnection_executeBatchCombined(conn, cursor, statements,
+                &results);
+    if (status > 0)
+        results = cxoConnection_executeBatchSequentially(conn, cursor,
+                statements);
+    Py_DECREF(cursor);
+    Py_DECREF(statements);
+
+    return results;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_getPendingErrorCode()
+//   Return the Oracle error code of the database error that is currently
+// being raised, or 0 if the current exception is not a database error.
+//-----------------------------------------------------------------------------
+static long cxoConnection_getPendingErrorCode(void)
+{
+    PyObject *type, *value, *traceback, *errorObj;
+    long code = 0;
+
+    if (!PyErr_ExceptionMatches(cxoDatabaseErrorException))
+        return 0;
+    PyErr_Fetch(&type, &value, &traceback);
+    PyErr_NormalizeException(&type, &value, &traceback);
+    errorObj = PyObject_GetAttrString(value, "args");
+    if (!errorObj)
+        PyErr_Clear();
+    else {
+        if (PyTuple_Check(errorObj) && PyTuple_GET_SIZE(errorObj) > 0 &&
+                Py_TYPE(PyTuple_GET_ITEM(errorObj, 0)) == &cxoPyTypeError)
+            code = ((cxoError*) PyTuple_GET_ITEM(errorObj, 0))->code;
+        Py_DECREF(errorObj);
+    }
+    PyErr_Restore(type, value, traceback);
+    return code;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_splitTable()
+//   Return a list of ROWID ranges which together cover the given table and
+// which can be used to process it in parallel. The ranges are calculated from
+// the extents of the table found in the dictionary views; if those views are
+// not accessible, the ranges are calculated by distributing the rows of the
+// table evenly instead.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_splitTable(cxoConnection *conn, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "owner", "table", "numChunks", NULL };
+    PyObject *owner, *tableName, *cursor, *result, *sql;
+    unsigned int numChunks;
+    long errorCode;
+
+    // parse arguments
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "UUI", keywordList,
+            &owner, &tableName, &numChunks))
+        return NULL;
+    if (numChunks == 0)
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "numChunks must be greater than zero");
+    if (PyUnicode_FindChar(owner, '"', 0, PyUnicode_GET_LENGTH(owner),
+                    1) != -1 ||
+            PyUnicode_FindChar(tableName, '"', 0,
+                    PyUnicode_GET_LENGTH(tableName), 1) != -1)
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "owner and table names may not contain double quotes");
+
+    // make sure we are actually connected
+    if (cxoConnection_isConnected(conn) < 0)
+        return NULL;
+
+    // calculate the ranges from the extents of the table
+    cursor = PyObject_CallMethod((PyObject*) conn, "cursor", NULL);
+    if (!cursor)
+        return NULL;
+    result = PyObject_CallMethod(cursor, "execute", "s{sOsOsI}",
+            cxoConnectionSplitTableSql, "owner", owner, "tableName",
+            tableName, "numChunks", numChunks);
+
+    // if the dictionary views are not accessible, use the table itself
+    if (!result) {
+        errorCode = cxoConnection_getPendingErrorCode();
+        if (errorCode == 942 || errorCode == 1031) {
+            PyErr_Clear();
+            sql = PyUnicode_FromFormat(cxoConnectionSplitTableFallbackSql,
+                    owner, tableName);
+            if (sql) {
+                result = PyObject_CallMethod(cursor, "execute", "O{sI}", sql,
+                        "numChunks", numChunks);
+                Py_DECREF(sql);
+            }
+        }
+    }
+
+    // return the ranges that were calculated
+    if (result) {
+        Py_DECREF(result);
+        result = PyObject_CallMethod(cursor, "fetchall", NULL);
+    }
+    Py_DECREF(cursor);
+    return result;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_startup()
 //   Starts up the database, equivalent to "startup nomount" in SQL*Plus.
@@ -1728,9 +3251,10 @@ static PyObject *cxoConnection_subscribe(cxoConnection *conn, PyObject* args,
     static char *keywordList[] = { "namespace", "protocol", "callback",
             "timeout", "operations", "port", "qos", "ipAddress",
             "groupingClass", "groupingValue", "groupingType", "name",
-            "clientInitiated", NULL };
+            "clientInitiated", "bufferSize", "coalesceWindow", NULL };
     PyObject *callback, *ipAddress, *name, *clientInitiatedObj;
     cxoBuffer ipAddressBuffer, nameBuffer;
+    uint32_t bufferSize, coalesceWindow;
     dpiSubscrCreateParams params;
     cxoSubscr *subscr;
 
@@ -1740,12 +3264,13 @@ static PyObject *cxoConnection_subscribe(cxoConnection *conn, PyObject* args,
 
     // validate parameters
     callback = name = ipAddress = clientInitiatedObj = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|IIOIIIIObIbOO",
+    bufferSize = coalesceWindow = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|IIOIIIIObIbOOII",
             keywordList, &params.subscrNamespace, &params.protocol, &callback,
             &params.timeout, &params.operations, &params.portNumber,
             &params.qos, &ipAddress, &params.groupingClass,
             &params.groupingValue, &params.groupingType, &name,
-            &clientInitiatedObj))
+            &clientInitiatedObj, &bufferSize, &coalesceWindow))
         return NULL;
     if (cxoConnection_isConnected(conn) < 0)
         return NULL;
@@ -1799,11 +3324,20 @@ static PyObject *cxoConnection_subscribe(cxoConnection *conn, PyObject* args,
     subscr->groupingClass = params.groupingClass;
     subscr->groupingValue = params.groupingValue;
     subscr->groupingType = params.groupingType;
+    subscr->bufferSize = bufferSize;
+    subscr->coalesceWindow = coalesceWindow;
 
-    // populate callback in parameters, if applicable
+    // populate callback in parameters, if applicable; if messages are to be
+    // buffered, start the thread which delivers them to the callback
     if (callback) {
         params.callback = (dpiSubscrCallback) cxoSubscr_callback;
         params.callbackContext = subscr;
+        if (bufferSize > 0 && cxoSubscr_startDelivery(subscr) < 0) {
+            cxoBuffer_clear(&ipAddressBuffer);
+            cxoBuffer_clear(&nameBuffer);
+            Py_DECREF(subscr);
+            return NULL;
+        }
     }
 
     // create ODPI-C subscription
@@ -1811,6 +3345,7 @@ static PyObject *cxoConnection_subscribe(cxoConnection *conn, PyObject* args,
         cxoError_raiseAndReturnNull();
         cxoBuffer_clear(&ipAddressBuffer);
         cxoBuffer_clear(&nameBuffer);
+        cxoSubscr_stopDelivery(subscr);
         Py_DECREF(subscr);
         return NULL;
     }
@@ -1849,6 +3384,13 @@ static PyObject *cxoConnection_unsubscribe(cxoConnection *conn, PyObject* args,
     if (status < 0)
         return cxoError_raiseAndReturnNull();
     subscr->handle = NULL;
+    cxoSubscr_stopDelivery(subscr);
+
+    // the result cache can no longer be kept up to date by this subscription
+    if (conn->resultCacheSubscr == subscr) {
+        cxoConnection_resetResultCache(conn);
+        Py_CLEAR(conn->resultCacheSubscr);
+    }
 
     Py_RETURN_NONE;
 }
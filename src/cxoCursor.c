@@ -14,6 +14,13 @@
 
 #include "cxoModule.h"
 
+// constants used when automatically tuning the fetch array size
+#define CXO_CURSOR_TUNE_NUM_SAMPLES             3
+#define CXO_CURSOR_TUNE_MAX_GROWTH              8.0
+#define CXO_CURSOR_TUNE_TARGET_LATENCY          50.0
+#define CXO_CURSOR_TUNE_TARGET_BUFFER_SIZE      (4 * 1024 * 1024)
+#define CXO_CURSOR_TUNE_MAX_STATEMENTS          1000
+
 //-----------------------------------------------------------------------------
 // functions for the Python type "Cursor"
 //-----------------------------------------------------------------------------
@@ -30,6 +37,9 @@ static PyObject *cxoCursor_fetchOne(cxoCursor*, PyObject*);
 static PyObject *cxoCursor_fetchMany(cxoCursor*, PyObject*, PyObject*);
 static PyObject *cxoCursor_fetchAll(cxoCursor*, PyObject*);
 static PyObject *cxoCursor_fetchRaw(cxoCursor*, PyObject*, PyObject*);
+static PyObject *cxoCursor_fetchSerialized(cxoCursor*, PyObject*,
+        PyObject*);
+static PyObject *cxoCursor_fetchColumns(cxoCursor*, PyObject*, PyObject*);
 static PyObject *cxoCursor_parse(cxoCursor*, PyObject*);
 static PyObject *cxoCursor_prepare(cxoCursor*, PyObject*);
 static PyObject *cxoCursor_scroll(cxoCursor*, PyObject*, PyObject*);
@@ -40,6 +50,8 @@ static PyObject *cxoCursor_arrayVar(cxoCursor*, PyObject*);
 static PyObject *cxoCursor_bindNames(cxoCursor*, PyObject*);
 static PyObject *cxoCursor_getDescription(cxoCursor*, void*);
 static PyObject *cxoCursor_getLastRowid(cxoCursor*, void*);
+static PyObject *cxoCursor_getEpochUnit(cxoCursor*, void*);
+static int cxoCursor_setEpochUnit(cxoCursor*, PyObject*, void*);
 static PyObject *cxoCursor_new(PyTypeObject*, PyObject*, PyObject*);
 static int cxoCursor_init(cxoCursor*, PyObject*, PyObject*);
 static PyObject *cxoCursor_repr(cxoCursor*);
@@ -48,7 +60,11 @@ static PyObject *cxoCursor_getArrayDMLRowCounts(cxoCursor*);
 static PyObject *cxoCursor_getImplicitResults(cxoCursor*);
 static PyObject *cxoCursor_contextManagerEnter(cxoCursor*, PyObject*);
 static PyObject *cxoCursor_contextManagerExit(cxoCursor*, PyObject*);
-static int cxoCursor_performDefine(cxoCursor*, uint32_t);
+static void cxoCursor_clearAdaptiveSizes(cxoCursor*);
+static int cxoCursor_growAdaptiveColumns(cxoCursor*);
+static int cxoCursor_isTruncationError(dpiErrorInfo*);
+static int cxoCursor_raiseFetchError(cxoCursor*, dpiErrorInfo*);
+static int cxoCursor_tuneArraySize(cxoCursor*, double);
 
 
 //-----------------------------------------------------------------------------
@@ -63,6 +79,10 @@ static PyMethodDef cxoCursorMethods[] = {
               METH_VARARGS | METH_KEYWORDS },
     { "fetchraw", (PyCFunction) cxoCursor_fetchRaw,
               METH_VARARGS | METH_KEYWORDS },
+    { "fetch_serialized", (PyCFunction) cxoCursor_fetchSerialized,
+              METH_VARARGS | METH_KEYWORDS },
+    { "fetch_columns", (PyCFunction) cxoCursor_fetchColumns,
+              METH_VARARGS | METH_KEYWORDS },
     { "prepare", (PyCFunction) cxoCursor_prepare, METH_VARARGS },
     { "parse", (PyCFunction) cxoCursor_parse, METH_O },
     { "setinputsizes", (PyCFunction) cxoCursor_setInputSizes,
@@ -96,7 +116,10 @@ static PyMethodDef cxoCursorMethods[] = {
 // declaration of members for Python type "Cursor"
 //-----------------------------------------------------------------------------
 static PyMemberDef cxoCursorMembers[] = {
+    { "adaptivefetchsize", T_UINT, offsetof(cxoCursor, adaptiveFetchSize),
+            0 },
     { "arraysize", T_UINT, offsetof(cxoCursor, arraySize), 0 },
+    { "autoarraysize", T_BOOL, offsetof(cxoCursor, autoArraySize), 0 },
     { "bindarraysize", T_UINT, offsetof(cxoCursor, bindArraySize), 0 },
     { "rowcount", T_ULONGLONG, offsetof(cxoCursor, rowCount), READONLY },
     { "statement", T_OBJECT, offsetof(cxoCursor, statement), READONLY },
@@ -119,6 +142,8 @@ static PyMemberDef cxoCursorMembers[] = {
 static PyGetSetDef cxoCursorCalcMembers[] = {
     { "description", (getter) cxoCursor_getDescription, 0, 0, 0 },
     { "lastrowid", (getter) cxoCursor_getLastRowid, 0, 0, 0 },
+    { "epochunit", (getter) cxoCursor_getEpochUnit,
+            (setter) cxoCursor_setEpochUnit, 0, 0 },
     { NULL }
 };
 
@@ -221,6 +246,7 @@ static void cxoCursor_free(cxoCursor *cursor)
     Py_CLEAR(cursor->statementTag);
     Py_CLEAR(cursor->bindVariables);
     Py_CLEAR(cursor->fetchVariables);
+    cxoCursor_clearAdaptiveSizes(cursor);
     if (cursor->handle) {
         dpiStmt_release(cursor->handle);
         cursor->handle = NULL;
@@ -284,6 +310,296 @@ static int cxoCursor_verifyFetch(cxoCursor *cursor)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_getTunedArraySize()
+//   Return the fetch array size learned from earlier executions of the
+// statement on the connection, if one is available.
+//-----------------------------------------------------------------------------
+static int cxoCursor_getTunedArraySize(cxoCursor *cursor,
+        uint32_t *arraySize)
+{
+    PyObject *value;
+
+    if (!cursor->statement || !cursor->connection->tunedArraySizes)
+        return 0;
+    value = PyDict_GetItemWithError(cursor->connection->tunedArraySizes,
+            cursor->statement);
+    if (!value)
+        return (PyErr_Occurred()) ? -1 : 0;
+    *arraySize = (uint32_t) PyLong_AsUnsignedLong(value);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_isAdaptiveTransform()
+//   Return whether or not variables using the given transform may be defined
+// with a reduced size when adaptive fetching is enabled.
+//-----------------------------------------------------------------------------
+static int cxoCursor_isAdaptiveTransform(cxoTransformNum transformNum)
+{
+    switch (transformNum) {
+        case CXO_TRANSFORM_BINARY:
+        case CXO_TRANSFORM_FIXED_CHAR:
+        case CXO_TRANSFORM_FIXED_NCHAR:
+        case CXO_TRANSFORM_NSTRING:
+        case CXO_TRANSFORM_STRING:
+            return 1;
+        default:
+            break;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_isTemporalTransform()
+//   Return whether or not variables using the given transform may be fetched
+// as the time elapsed since the epoch when an epoch unit has been set.
+//-----------------------------------------------------------------------------
+static int cxoCursor_isTemporalTransform(cxoTransformNum transformNum)
+{
+    switch (transformNum) {
+        case CXO_TRANSFORM_DATE:
+        case CXO_TRANSFORM_DATETIME:
+        case CXO_TRANSFORM_TIMESTAMP:
+        case CXO_TRANSFORM_TIMESTAMP_LTZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ:
+            return 1;
+        default:
+            break;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_isTimeZoneColumn()
+//   Return whether or not the column is a timestamp with a time zone. When
+// such columns are fetched as the time elapsed since the epoch they are
+// defined with the time zone type so that the offset is available and the
+// value can be computed relative to UTC.
+//-----------------------------------------------------------------------------
+static int cxoCursor_isTimeZoneColumn(dpiQueryInfo *queryInfo)
+{
+    return (queryInfo->typeInfo.oracleTypeNum ==
+                    DPI_ORACLE_TYPE_TIMESTAMP_TZ ||
+            queryInfo->typeInfo.oracleTypeNum ==
+                    DPI_ORACLE_TYPE_TIMESTAMP_LTZ);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_clearAdaptiveSizes()
+//   Clear the sizes with which columns have been defined when adaptive
+// fetching is enabled.
+//-----------------------------------------------------------------------------
+static void cxoCursor_clearAdaptiveSizes(cxoCursor *cursor)
+{
+    if (cursor->adaptiveSizes) {
+        PyMem_Free(cursor->adaptiveSizes);
+        cursor->adaptiveSizes = NULL;
+    }
+    cursor->numAdaptiveSizes = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_isTruncationError()
+//   Return whether or not the error indicates that a fetched value did not
+// fit in the variable in which it was defined. ODPI-C reports these as
+// DPI-1037 (with error ORA-01406) or as ORA-01406/ORA-24345 directly.
+//-----------------------------------------------------------------------------
+static int cxoCursor_isTruncationError(dpiErrorInfo *errorInfo)
+{
+    return (errorInfo->code == 1406 || errorInfo->code == 24345 ||
+            (errorInfo->code == 1037 &&
+                    strncmp(errorInfo->message, "DPI-1037:", 9) == 0));
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_growAdaptiveColumns()
+//   Called when a fetch has failed. If the fetch failed because a value did
+// not fit in a column that was defined with a reduced size due to adaptive
+// fetching, the reduced columns are defined again with their full size and
+// the rows of the failed fetch are fetched again; otherwise, the error is
+// raised.
+//-----------------------------------------------------------------------------
+static int cxoCursor_growAdaptiveColumns(cxoCursor *cursor)
+{
+    uint32_t pos, size, numGrown;
+    dpiErrorInfo errorInfo;
+    dpiQueryInfo queryInfo;
+    uint64_t startRow;
+    cxoVar *var;
+    int status;
+
+    // only truncation can be handled and only if the rows can be fetched
+    // again, which requires a scrollable statement
+    dpiContext_getError(cxoDpiContext, &errorInfo);
+    if (!cursor->adaptiveSizes || !cursor->isPreparedScrollable ||
+            !cxoCursor_isTruncationError(&errorInfo))
+        return cxoCursor_raiseFetchError(cursor, &errorInfo);
+
+    // ODPI-C does not indicate which column could not hold its value so each
+    // column defined with a reduced size is defined again with its full size
+    numGrown = 0;
+    for (pos = 1; pos <= cursor->numAdaptiveSizes; pos++) {
+        if (!cursor->adaptiveSizes[pos - 1])
+            continue;
+        if (dpiStmt_getQueryInfo(cursor->handle, pos, &queryInfo) < 0)
+            return cxoError_raiseAndReturnInt();
+        if (queryInfo.typeInfo.sizeInChars)
+            size = queryInfo.typeInfo.sizeInChars;
+        else size = queryInfo.typeInfo.clientSizeInBytes;
+        var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, pos - 1);
+        if (var->size >= size)
+            continue;
+        var = cxoVar_new(cursor, cursor->fetchArraySize, var->transformNum,
+                size, 0, NULL);
+        if (!var)
+            return -1;
+        PyList_SetItem(cursor->fetchVariables, pos - 1, (PyObject*) var);
+        if (dpiStmt_define(cursor->handle, pos, var->handle) < 0)
+            return cxoError_raiseAndReturnInt();
+        cursor->adaptiveSizes[pos - 1] = size;
+        numGrown++;
+    }
+    startRow = cursor->rowCount + 1;
+    if (numGrown == 0 || startRow > INT32_MAX)
+        return cxoCursor_raiseFetchError(cursor, &errorInfo);
+
+    // fetch the rows of the failed fetch again; ODPI-C satisfies a scroll to
+    // a row found in its fetch buffer without fetching so the cursor is first
+    // positioned on a row outside of the rows of the failed fetch (the row
+    // preceding them or, if there is no such row, the last row)
+    Py_BEGIN_ALLOW_THREADS
+    if (startRow > 1)
+        status = dpiStmt_scroll(cursor->handle, DPI_MODE_FETCH_ABSOLUTE,
+                (int32_t) (startRow - 1), 0);
+    else status = dpiStmt_scroll(cursor->handle, DPI_MODE_FETCH_LAST, 0, 0);
+    if (status == 0)
+        status = dpiStmt_scroll(cursor->handle, DPI_MODE_FETCH_ABSOLUTE,
+                (int32_t) startRow, 0);
+    if (status == 0)
+        status = dpiStmt_fetchRows(cursor->handle, cursor->fetchArraySize,
+                &cursor->fetchBufferRowIndex, &cursor->numRowsInFetchBuffer,
+                &cursor->moreRowsToFetch);
+    Py_END_ALLOW_THREADS
+    if (status < 0)
+        return cxoError_raiseAndReturnInt();
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_raiseFetchError()
+//   Raise the error from a failed fetch. If the fetch failed because a value
+// did not fit in a column that was defined with a reduced size due to
+// adaptive fetching and the column could not be grown, a clearer error is
+// raised instead.
+//-----------------------------------------------------------------------------
+static int cxoCursor_raiseFetchError(cxoCursor *cursor,
+        dpiErrorInfo *errorInfo)
+{
+    char message[200];
+
+    if (!cursor->adaptiveSizes || !cxoCursor_isTruncationError(errorInfo))
+        return cxoError_raiseFromInfo(errorInfo);
+    snprintf(message, sizeof(message),
+            "a fetched value exceeds Cursor.adaptivefetchsize (%u); set "
+            "Cursor.adaptivefetchsize to 0 (or a larger value) and execute "
+            "the query again", cursor->adaptiveDefineSize);
+    cxoError_raiseFromString(cxoDataErrorException, message);
+    return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_tuneArraySize()
+//   Record the number of rows and the time taken by a fetch requiring a round
+// trip. Once enough round trips have been sampled (or all of the rows have
+// been fetched), a new fetch array size is calculated and stored on the
+// connection for use by subsequent executions of the statement. The size is
+// scaled toward the target latency per round trip and is limited by the
+// amount of memory required for the fetch buffers.
+//-----------------------------------------------------------------------------
+static int cxoCursor_tuneArraySize(cxoCursor *cursor, double elapsed)
+{
+    uint32_t pos, numVars, bytesPerRow;
+    double factor, newSize, maxSize;
+    PyObject *value;
+    cxoVar *var;
+    int status;
+
+    // record the statistics for the round trip
+    cursor->tuneRoundTrips++;
+    cursor->tuneNumRows += cursor->numRowsInFetchBuffer;
+    cursor->tuneElapsed += elapsed;
+    if (!cursor->statement || (cursor->moreRowsToFetch &&
+            cursor->tuneRoundTrips < CXO_CURSOR_TUNE_NUM_SAMPLES))
+        return 0;
+
+    // if all of the rows were fetched in a single round trip, the array size
+    // can be reduced to what was actually needed (with some headroom);
+    // otherwise, scale the array size toward the target latency
+    if (!cursor->moreRowsToFetch && cursor->tuneRoundTrips == 1) {
+        newSize = (double) (cursor->tuneNumRows + cursor->tuneNumRows / 4 + 1);
+        if (newSize > cursor->fetchArraySize)
+            newSize = cursor->fetchArraySize;
+    } else {
+        factor = CXO_CURSOR_TUNE_MAX_GROWTH;
+        if (cursor->tuneElapsed > 0)
+            factor = CXO_CURSOR_TUNE_TARGET_LATENCY /
+                    (cursor->tuneElapsed / cursor->tuneRoundTrips);
+        if (factor > CXO_CURSOR_TUNE_MAX_GROWTH)
+            factor = CXO_CURSOR_TUNE_MAX_GROWTH;
+        else if (factor < 0.5)
+            factor = 0.5;
+        newSize = cursor->fetchArraySize * factor;
+    }
+
+    // limit the size by the memory required to hold each row
+    bytesPerRow = 0;
+    numVars = (uint32_t) PyList_GET_SIZE(cursor->fetchVariables);
+    for (pos = 0; pos < numVars; pos++) {
+        var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, pos);
+        bytesPerRow += var->bufferSize;
+    }
+    if (bytesPerRow > 0) {
+        maxSize = (double) CXO_CURSOR_TUNE_TARGET_BUFFER_SIZE / bytesPerRow;
+        if (newSize > maxSize)
+            newSize = maxSize;
+    }
+    if (newSize < 1)
+        newSize = 1;
+
+    // store the new size on the connection, unless too many statements are
+    // already being tracked
+    if (!cursor->connection->tunedArraySizes) {
+        cursor->connection->tunedArraySizes = PyDict_New();
+        if (!cursor->connection->tunedArraySizes)
+            return -1;
+    }
+    if (PyDict_Size(cursor->connection->tunedArraySizes) >=
+            CXO_CURSOR_TUNE_MAX_STATEMENTS) {
+        status = PyDict_Contains(cursor->connection->tunedArraySizes,
+                cursor->statement);
+        if (status <= 0)
+            return status;
+    }
+    value = PyLong_FromUnsignedLong((unsigned long) newSize);
+    if (!value)
+        return -1;
+    status = PyDict_SetItem(cursor->connection->tunedArraySizes,
+            cursor->statement, value);
+    Py_DECREF(value);
+    return status;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_fetchRow()
 //   Fetch a single row from the cursor. Internally the number of rows left in
@@ -293,19 +609,26 @@ static int cxoCursor_verifyFetch(cxoCursor *cursor)
 static int cxoCursor_fetchRow(cxoCursor *cursor, int *found,
         uint32_t *bufferRowIndex)
 {
+    double startTime;
     int status;
 
     // if the number of rows in the fetch buffer is zero and there are more
     // rows to fetch, call DPI with threading enabled in order to perform any
     // fetch requiring a network round trip
     if (cursor->numRowsInFetchBuffer == 0 && cursor->moreRowsToFetch) {
+        startTime = (cursor->autoArraySize) ? cxoUtils_getMonotonicTime() : 0;
         Py_BEGIN_ALLOW_THREADS
         status = dpiStmt_fetchRows(cursor->handle, cursor->fetchArraySize,
                 &cursor->fetchBufferRowIndex, &cursor->numRowsInFetchBuffer,
                 &cursor->moreRowsToFetch);
         Py_END_ALLOW_THREADS
-        if (status < 0)
-            return cxoError_raiseAndReturnInt();
+        if (status < 0 && cxoCursor_growAdaptiveColumns(cursor) < 0)
+            return -1;
+        if (cursor->autoArraySize &&
+                cursor->tuneRoundTrips < CXO_CURSOR_TUNE_NUM_SAMPLES &&
+                cxoCursor_tuneArraySize(cursor,
+                        cxoUtils_getMonotonicTime() - startTime) < 0)
+            return -1;
     }
 
     // keep track of where we are in the fetch buffer
@@ -326,16 +649,17 @@ static int cxoCursor_fetchRow(cxoCursor *cursor, int *found,
 //   Perform the defines for the cursor. At this point it is assumed that the
 // statement being executed is in fact a query.
 //-----------------------------------------------------------------------------
-static int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
+int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
 {
+    cxoTransformNum transformNum, epochTransformNum;
     PyObject *outputTypeHandler, *result;
-    cxoTransformNum transformNum;
     cxoObjectType *objectType;
     dpiQueryInfo queryInfo;
-    uint32_t pos, size;
+    uint32_t pos, size, fetchArraySize, adaptiveSize;
+    int setArraySizeAfterDefine;
     cxoDbType *dbType;
     char message[120];
-    cxoVar *var;
+    cxoVar *var, *tempVar;
 
     // initialize fetching variables; these are used to reduce the number of
     // times that Py_BEGIN_ALLOW_THREADS/Py_END_ALLOW_THREADS is called as
@@ -343,19 +667,61 @@ static int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
     cursor->numRowsInFetchBuffer = 0;
     cursor->moreRowsToFetch = 1;
 
+    // determine the fetch array size to use; when the array size is being
+    // tuned automatically, use the size learned for the statement, if any
+    fetchArraySize = cursor->arraySize;
+    if (cursor->autoArraySize) {
+        cursor->tuneRoundTrips = 0;
+        cursor->tuneNumRows = 0;
+        cursor->tuneElapsed = 0;
+        if (cxoCursor_getTunedArraySize(cursor, &fetchArraySize) < 0)
+            return -1;
+    }
+
     // if fetch variables already exist, nothing more to do (we are executing
     // the same statement and therefore all defines have already been
-    // performed)
-    if (cursor->fetchVariables)
-        return 0;
+    // performed) unless the tuned array size has changed or the adaptive
+    // fetch size has changed since the columns were defined; the array size
+    // used by ODPI-C must not exceed the size of the defined variables so it
+    // is only increased after the new variables have been defined
+    setArraySizeAfterDefine = 0;
+    if (cursor->fetchVariables) {
+        if (cursor->adaptiveFetchSize != cursor->adaptiveDefineSize) {
+            if (!cursor->autoArraySize)
+                fetchArraySize = cursor->fetchArraySize;
+        } else if (!cursor->autoArraySize ||
+                fetchArraySize == cursor->fetchArraySize)
+            return 0;
+        setArraySizeAfterDefine = (fetchArraySize > cursor->fetchArraySize);
+        Py_CLEAR(cursor->fetchVariables);
+    }
+    if (cursor->autoArraySize && !setArraySizeAfterDefine &&
+            dpiStmt_setFetchArraySize(cursor->handle, fetchArraySize) < 0)
+        return cxoError_raiseAndReturnInt();
 
     // create a list corresponding to the number of items
     cursor->fetchVariables = PyList_New(numQueryColumns);
     if (!cursor->fetchVariables)
         return -1;
 
+    // when adaptive fetching is enabled, keep track of the largest size with
+    // which each column has been defined; columns that have been grown after
+    // a value did not fit remain so for as long as the statement is retained
+    if (cursor->adaptiveFetchSize > 0 &&
+            cursor->numAdaptiveSizes != numQueryColumns) {
+        cxoCursor_clearAdaptiveSizes(cursor);
+        cursor->adaptiveSizes = PyMem_Calloc(numQueryColumns,
+                sizeof(uint32_t));
+        if (!cursor->adaptiveSizes) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        cursor->numAdaptiveSizes = numQueryColumns;
+    }
+
     // create a variable for each of the query columns
-    cursor->fetchArraySize = cursor->arraySize;
+    cursor->fetchArraySize = fetchArraySize;
+    cursor->adaptiveDefineSize = cursor->adaptiveFetchSize;
     for (pos = 1; pos <= numQueryColumns; pos++) {
 
         // get query information for the column position
@@ -426,14 +792,77 @@ static int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
             }
         }
 
-        // if no variable created yet, use the database metadata
+        // if no variable created yet, use the database metadata; when
+        // adaptive fetching is enabled, string and raw columns are defined
+        // with a reduced size (or the size to which they were grown
+        // previously); date and timestamp columns are fetched as integers if
+        // an epoch unit has been set on the cursor
         if (!var) {
+            epochTransformNum = CXO_TRANSFORM_NONE;
+            if (cursor->epochTransformNum != CXO_TRANSFORM_NONE &&
+                    cxoCursor_isTemporalTransform(transformNum)) {
+                epochTransformNum = cursor->epochTransformNum;
+                if (!cxoCursor_isTimeZoneColumn(&queryInfo))
+                    transformNum = epochTransformNum;
+                else transformNum = CXO_TRANSFORM_TIMESTAMP_TZ;
+            }
+            if (cursor->adaptiveFetchSize > 0 &&
+                    size > cursor->adaptiveFetchSize &&
+                    cxoCursor_isAdaptiveTransform(transformNum)) {
+                adaptiveSize = cursor->adaptiveSizes[pos - 1];
+                if (adaptiveSize < cursor->adaptiveFetchSize)
+                    adaptiveSize = cursor->adaptiveFetchSize;
+                if (adaptiveSize < size) {
+                    size = adaptiveSize;
+                    cursor->adaptiveSizes[pos - 1] = size;
+                }
+            }
             var = cxoVar_new(cursor, cursor->fetchArraySize, transformNum,
                     size, 0, objectType);
             if (!var) {
                 Py_XDECREF(objectType);
                 return -1;
             }
+            if (epochTransformNum != CXO_TRANSFORM_NONE)
+                var->transformNum = epochTransformNum;
+
+        // variables returned by an output type handler for fetching
+        // timestamps with time zones as the time elapsed since the epoch are
+        // replaced by one with the time zone type for the same reason
+        } else if (cxoTransform_getEpochUnitsPerSecond(var->transformNum) &&
+                cxoCursor_isTimeZoneColumn(&queryInfo) &&
+                var->dbType != cxoDbTypeTimestampTZ) {
+            tempVar = cxoVar_new(cursor, var->allocatedElements,
+                    CXO_TRANSFORM_TIMESTAMP_TZ, 0, 0, NULL);
+            if (!tempVar) {
+                Py_DECREF(var);
+                Py_XDECREF(objectType);
+                return -1;
+            }
+            tempVar->transformNum = var->transformNum;
+            tempVar->outConverter = var->outConverter;
+            var->outConverter = NULL;
+            Py_DECREF(var);
+            var = tempVar;
+        }
+
+        // scaled integers require a number with a known precision and scale
+        // (which is recorded in the variable)
+        if (var->transformNum == CXO_TRANSFORM_SCALED_INT) {
+            if (queryInfo.typeInfo.oracleTypeNum != DPI_ORACLE_TYPE_NUMBER ||
+                    queryInfo.typeInfo.precision < 1 ||
+                    queryInfo.typeInfo.precision > 18 ||
+                    queryInfo.typeInfo.scale < 0) {
+                Py_DECREF(var);
+                Py_XDECREF(objectType);
+                snprintf(message, sizeof(message),
+                        "column %u must be a number with a precision of 18 "
+                        "or less to be fetched as a scaled integer", pos);
+                cxoError_raiseFromString(cxoNotSupportedErrorException,
+                        message);
+                return -1;
+            }
+            var->scale = queryInfo.typeInfo.scale;
         }
 
         // add the variable to the fetch variables and perform define
@@ -444,6 +873,10 @@ static int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
 
     }
 
+    if (setArraySizeAfterDefine &&
+            dpiStmt_setFetchArraySize(cursor->handle, fetchArraySize) < 0)
+        return cxoError_raiseAndReturnInt();
+
     return 0;
 }
 
@@ -622,6 +1055,65 @@ static PyObject *cxoCursor_getLastRowid(cxoCursor *cursor, void *unused)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_getEpochUnit()
+//   Return the unit in which date and timestamp columns are fetched as the
+// time elapsed since the epoch, or None if they are fetched as datetime
+// objects.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_getEpochUnit(cxoCursor *cursor, void *unused)
+{
+    switch (cursor->epochTransformNum) {
+        case CXO_TRANSFORM_EPOCH_S:
+            return PyUnicode_FromString("s");
+        case CXO_TRANSFORM_EPOCH_MS:
+            return PyUnicode_FromString("ms");
+        case CXO_TRANSFORM_EPOCH_US:
+            return PyUnicode_FromString("us");
+        case CXO_TRANSFORM_EPOCH_NS:
+            return PyUnicode_FromString("ns");
+        default:
+            break;
+    }
+    Py_RETURN_NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_setEpochUnit()
+//   Set the unit in which date and timestamp columns are fetched as the time
+// elapsed since the epoch. The value None restores the default behavior of
+// fetching them as datetime objects. Only queries executed after the value
+// is set are affected.
+//-----------------------------------------------------------------------------
+static int cxoCursor_setEpochUnit(cxoCursor *cursor, PyObject *value,
+        void *unused)
+{
+    const char *unit;
+
+    if (!value || value == Py_None) {
+        cursor->epochTransformNum = CXO_TRANSFORM_NONE;
+        return 0;
+    }
+    unit = (PyUnicode_Check(value)) ? PyUnicode_AsUTF8(value) : NULL;
+    if (unit && strcmp(unit, "s") == 0)
+        cursor->epochTransformNum = CXO_TRANSFORM_EPOCH_S;
+    else if (unit && strcmp(unit, "ms") == 0)
+        cursor->epochTransformNum = CXO_TRANSFORM_EPOCH_MS;
+    else if (unit && strcmp(unit, "us") == 0)
+        cursor->epochTransformNum = CXO_TRANSFORM_EPOCH_US;
+    else if (unit && strcmp(unit, "ns") == 0)
+        cursor->epochTransformNum = CXO_TRANSFORM_EPOCH_NS;
+    else {
+        PyErr_Clear();
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "epoch unit must be None or one of 's', 'ms', 'us' or 'ns'");
+        return -1;
+    }
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_close()
 //   Close the cursor. Any action taken on this cursor from this point forward
@@ -633,6 +1125,7 @@ static PyObject *cxoCursor_close(cxoCursor *cursor, PyObject *args)
         return NULL;
     Py_CLEAR(cursor->bindVariables);
     Py_CLEAR(cursor->fetchVariables);
+    cxoCursor_clearAdaptiveSizes(cursor);
     if (cursor->handle) {
         if (dpiStmt_close(cursor->handle, NULL, 0) < 0)
             return cxoError_raiseAndReturnNull();
@@ -935,7 +1428,7 @@ static int cxoCursor_internalPrepare(cxoCursor *cursor, PyObject *statement,
         PyObject *statementTag)
 {
     cxoBuffer statementBuffer, tagBuffer;
-    int status;
+    int status, isScrollable;
 
     // make sure we don't get a situation where nothing is to be executed
     if (statement == Py_None && !cursor->statement) {
@@ -944,10 +1437,24 @@ static int cxoCursor_internalPrepare(cxoCursor *cursor, PyObject *statement,
         return -1;
     }
 
+    // the statement of a prepared statement object cannot be replaced
+    if (cursor->fixedStatement && statement != Py_None &&
+            statement != cursor->statement) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "the statement of a prepared statement cannot be changed");
+        return -1;
+    }
+
+    // statements are prepared scrollable when adaptive fetching is enabled so
+    // that rows can be fetched again after columns have been grown
+    isScrollable = (cursor->isScrollable || cursor->adaptiveFetchSize > 0);
+
     // nothing to do if the statement is identical to the one already stored
     // but go ahead and prepare anyway for create, alter and drop statments
+    // and for statements that must now be prepared scrollable
     if (statement == Py_None || statement == cursor->statement) {
-        if (cursor->handle && !cursor->stmtInfo.isDDL)
+        if (cursor->handle && !cursor->stmtInfo.isDDL &&
+                (cursor->isPreparedScrollable || !isScrollable))
             return 0;
         statement = cursor->statement;
     }
@@ -964,6 +1471,7 @@ static int cxoCursor_internalPrepare(cxoCursor *cursor, PyObject *statement,
 
     // clear fetch and bind variables if applicable
     Py_CLEAR(cursor->fetchVariables);
+    cxoCursor_clearAdaptiveSizes(cursor);
     if (!cursor->setInputSizes)
         Py_CLEAR(cursor->bindVariables);
 
@@ -980,7 +1488,7 @@ static int cxoCursor_internalPrepare(cxoCursor *cursor, PyObject *statement,
     if (cursor->handle)
         dpiStmt_release(cursor->handle);
     status = dpiConn_prepareStmt(cursor->connection->handle,
-            cursor->isScrollable, (const char*) statementBuffer.ptr,
+            isScrollable, (const char*) statementBuffer.ptr,
             statementBuffer.size, (const char*) tagBuffer.ptr, tagBuffer.size,
             &cursor->handle);
     Py_END_ALLOW_THREADS
@@ -988,6 +1496,7 @@ static int cxoCursor_internalPrepare(cxoCursor *cursor, PyObject *statement,
     cxoBuffer_clear(&tagBuffer);
     if (status < 0)
         return cxoError_raiseAndReturnInt();
+    cursor->isPreparedScrollable = (char) isScrollable;
 
     // get statement information
     if (dpiStmt_getInfo(cursor->handle, &cursor->stmtInfo) < 0)
@@ -1657,6 +2166,7 @@ static PyObject *cxoCursor_fetchRaw(cxoCursor *cursor, PyObject *args,
 {
     static char *keywordList[] = { "numRows", NULL };
     uint32_t numRowsToFetch, numRowsFetched, bufferRowIndex;
+    dpiErrorInfo errorInfo;
     int moreRows;
 
     // expect an optional number of rows to retrieve
@@ -1670,14 +2180,112 @@ static PyObject *cxoCursor_fetchRaw(cxoCursor *cursor, PyObject *args,
 
     // perform the fetch
     if (dpiStmt_fetchRows(cursor->handle, numRowsToFetch, &bufferRowIndex,
-            &numRowsFetched, &moreRows) < 0)
-        return cxoError_raiseAndReturnNull();
+            &numRowsFetched, &moreRows) < 0) {
+        dpiContext_getError(cxoDpiContext, &errorInfo);
+        cxoCursor_raiseFetchError(cursor, &errorInfo);
+        return NULL;
+    }
     cursor->rowCount += numRowsFetched;
     cursor->numRowsInFetchBuffer = 0;
     return PyLong_FromLong(numRowsFetched);
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_fetchSerialized()
+//   Fetch rows from the cursor and return them in the compact binary format
+// understood by cx_Oracle.load_serialized(). The values are written directly
+// from the fetch buffers without creating Python objects for them.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_fetchSerialized(cxoCursor *cursor, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "numRows", NULL };
+    uint32_t bufferRowIndex = 0, numRows = 0;
+    cxoSerializeBuffer buf;
+    int found, rowLimit;
+
+    // parse arguments -- optional row limit expected
+    rowLimit = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|i", keywordList,
+            &rowLimit))
+        return NULL;
+
+    // verify fetch can be performed and write the header
+    if (cxoCursor_verifyFetch(cursor) < 0)
+        return NULL;
+    if (cxoSerialize_writeHeader(&buf, cursor) < 0) {
+        cxoSerialize_free(&buf);
+        return NULL;
+    }
+
+    // write as many rows as possible
+    while (rowLimit <= 0 || numRows < (uint32_t) rowLimit) {
+        if (cxoCursor_fetchRow(cursor, &found, &bufferRowIndex) < 0) {
+            cxoSerialize_free(&buf);
+            return NULL;
+        }
+        if (!found)
+            break;
+        cursor->rowCount++;
+        if (cxoSerialize_writeRow(&buf, cursor, bufferRowIndex) < 0) {
+            cxoSerialize_free(&buf);
+            return NULL;
+        }
+        numRows++;
+    }
+
+    return cxoSerialize_finish(&buf, numRows);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_fetchColumns()
+//   Fetch rows from the cursor and return them as a set of columns in the
+// layout understood by cx_Oracle.open_columns(), suitable for placing in
+// shared memory. The values are written directly from the fetch buffers.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_fetchColumns(cxoCursor *cursor, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "numRows", NULL };
+    uint32_t bufferRowIndex = 0, numRows = 0;
+    cxoColumnarWriter *writer;
+    int found, rowLimit;
+
+    // parse arguments -- optional row limit expected
+    rowLimit = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|i", keywordList,
+            &rowLimit))
+        return NULL;
+
+    // verify fetch can be performed and create the writer
+    if (cxoCursor_verifyFetch(cursor) < 0)
+        return NULL;
+    writer = cxoColumnar_newWriter(cursor);
+    if (!writer)
+        return NULL;
+
+    // write as many rows as possible
+    while (rowLimit <= 0 || numRows < (uint32_t) rowLimit) {
+        if (cxoCursor_fetchRow(cursor, &found, &bufferRowIndex) < 0) {
+            cxoColumnar_freeWriter(writer);
+            return NULL;
+        }
+        if (!found)
+            break;
+        cursor->rowCount++;
+        if (cxoColumnar_writeRow(writer, cursor, bufferRowIndex) < 0) {
+            cxoColumnar_freeWriter(writer);
+            return NULL;
+        }
+        numRows++;
+    }
+
+    return cxoColumnar_finish(writer);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_scroll()
 //   Scroll the cursor using the value and mode specified.
@@ -218,6 +218,7 @@ cxoDbType *cxoDbType_fromTransformNum(cxoTransformNum transformNum)
         case CXO_TRANSFORM_DECIMAL:
         case CXO_TRANSFORM_FLOAT:
         case CXO_TRANSFORM_INT:
+        case CXO_TRANSFORM_SCALED_INT:
             return cxoDbTypeNumber;
         case CXO_TRANSFORM_FIXED_CHAR:
             return cxoDbTypeChar;
@@ -246,11 +247,16 @@ cxoDbType *cxoDbType_fromTransformNum(cxoTransformNum transformNum)
             return cxoDbTypeVarchar;
         case CXO_TRANSFORM_TIMEDELTA:
             return cxoDbTypeIntervalDS;
+        case CXO_TRANSFORM_EPOCH_MS:
+        case CXO_TRANSFORM_EPOCH_NS:
+        case CXO_TRANSFORM_EPOCH_S:
+        case CXO_TRANSFORM_EPOCH_US:
         case CXO_TRANSFORM_TIMESTAMP:
             return cxoDbTypeTimestamp;
         case CXO_TRANSFORM_TIMESTAMP_LTZ:
             return cxoDbTypeTimestampLTZ;
         case CXO_TRANSFORM_TIMESTAMP_TZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ_AWARE:
             return cxoDbTypeTimestampTZ;
         default:
             break;
@@ -92,8 +92,14 @@ cxoDbType *cxoDbTypeVarchar = NULL;
 
 cxoApiType *cxoApiTypeBinary = NULL;
 cxoApiType *cxoApiTypeDatetime = NULL;
+cxoApiType *cxoApiTypeDatetimeTZ = NULL;
+cxoApiType *cxoApiTypeEpochMS = NULL;
+cxoApiType *cxoApiTypeEpochNS = NULL;
+cxoApiType *cxoApiTypeEpochS = NULL;
+cxoApiType *cxoApiTypeEpochUS = NULL;
 cxoApiType *cxoApiTypeNumber = NULL;
 cxoApiType *cxoApiTypeRowid = NULL;
+cxoApiType *cxoApiTypeScaledInt = NULL;
 cxoApiType *cxoApiTypeString = NULL;
 
 cxoFuture *cxoFutureObj = NULL;
@@ -254,6 +260,26 @@ static PyObject* cxoModule_clientVersion(PyObject* self, PyObject* args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoModule_loadSerialized()
+//   Return the rows contained in data created by Cursor.fetch_serialized().
+//-----------------------------------------------------------------------------
+static PyObject* cxoModule_loadSerialized(PyObject* self, PyObject* data)
+{
+    return cxoSerialize_load(data);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoModule_openColumns()
+//   Return the columns contained in data created by Cursor.fetch_columns().
+//-----------------------------------------------------------------------------
+static PyObject* cxoModule_openColumns(PyObject* self, PyObject* data)
+{
+    return cxoColumnar_open(data);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoModule_time()
 //   Returns a time value suitable for binding.
@@ -308,6 +334,8 @@ static PyMethodDef cxoModuleMethods[] = {
     { "TimestampFromTicks", (PyCFunction) cxoModule_timestampFromTicks,
             METH_VARARGS },
     { "clientversion", (PyCFunction) cxoModule_clientVersion, METH_NOARGS },
+    { "load_serialized", (PyCFunction) cxoModule_loadSerialized, METH_O },
+    { "open_columns", (PyCFunction) cxoModule_openColumns, METH_O },
     { NULL }
 };
 
@@ -346,6 +374,7 @@ static PyObject *cxoModule_initialize(void)
 
     // prepare the types for use by the module
     CXO_MAKE_TYPE_READY(&cxoPyTypeApiType);
+    CXO_MAKE_TYPE_READY(&cxoPyTypeColumnData);
     CXO_MAKE_TYPE_READY(&cxoPyTypeConnection);
     CXO_MAKE_TYPE_READY(&cxoPyTypeCursor);
     CXO_MAKE_TYPE_READY(&cxoPyTypeDbType);
@@ -362,6 +391,7 @@ static PyObject *cxoModule_initialize(void)
     CXO_MAKE_TYPE_READY(&cxoPyTypeObjectAttr);
     CXO_MAKE_TYPE_READY(&cxoPyTypeObject);
     CXO_MAKE_TYPE_READY(&cxoPyTypeObjectType);
+    CXO_MAKE_TYPE_READY(&cxoPyTypePreparedStatement);
     CXO_MAKE_TYPE_READY(&cxoPyTypeQueue);
     CXO_MAKE_TYPE_READY(&cxoPyTypeSessionPool);
     CXO_MAKE_TYPE_READY(&cxoPyTypeSodaCollection);
@@ -423,6 +453,7 @@ static PyObject *cxoModule_initialize(void)
     CXO_ADD_TYPE_OBJECT("MessageProperties", &cxoPyTypeMsgProps)
     CXO_ADD_TYPE_OBJECT("Object", &cxoPyTypeObject)
     CXO_ADD_TYPE_OBJECT("ObjectType", &cxoPyTypeObjectType)
+    CXO_ADD_TYPE_OBJECT("PreparedStatement", &cxoPyTypePreparedStatement)
     CXO_ADD_TYPE_OBJECT("SessionPool", &cxoPyTypeSessionPool)
     CXO_ADD_TYPE_OBJECT("SodaCollection", &cxoPyTypeSodaCollection)
     CXO_ADD_TYPE_OBJECT("SodaDatabase", &cxoPyTypeSodaDatabase)
@@ -508,8 +539,16 @@ static PyObject *cxoModule_initialize(void)
     // create the Python Database API types
     CXO_ADD_API_TYPE("BINARY", CXO_TRANSFORM_BINARY, &cxoApiTypeBinary)
     CXO_ADD_API_TYPE("DATETIME", CXO_TRANSFORM_DATETIME, &cxoApiTypeDatetime)
+    CXO_ADD_API_TYPE("DATETIME_TZ", CXO_TRANSFORM_TIMESTAMP_TZ_AWARE,
+            &cxoApiTypeDatetimeTZ)
+    CXO_ADD_API_TYPE("EPOCH_MS", CXO_TRANSFORM_EPOCH_MS, &cxoApiTypeEpochMS)
+    CXO_ADD_API_TYPE("EPOCH_NS", CXO_TRANSFORM_EPOCH_NS, &cxoApiTypeEpochNS)
+    CXO_ADD_API_TYPE("EPOCH_S", CXO_TRANSFORM_EPOCH_S, &cxoApiTypeEpochS)
+    CXO_ADD_API_TYPE("EPOCH_US", CXO_TRANSFORM_EPOCH_US, &cxoApiTypeEpochUS)
     CXO_ADD_API_TYPE("NUMBER", CXO_TRANSFORM_FLOAT, &cxoApiTypeNumber)
     CXO_ADD_API_TYPE("ROWID", CXO_TRANSFORM_ROWID, &cxoApiTypeRowid)
+    CXO_ADD_API_TYPE("SCALED_INT", CXO_TRANSFORM_SCALED_INT,
+            &cxoApiTypeScaledInt)
     CXO_ADD_API_TYPE("STRING", CXO_TRANSFORM_STRING, &cxoApiTypeString)
 
     // associate the Python Database API types with the database types
@@ -521,11 +560,30 @@ static PyObject *cxoModule_initialize(void)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeDatetime, cxoDbTypeTimestamp)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeDatetime, cxoDbTypeTimestampLTZ)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeDatetime, cxoDbTypeTimestampTZ)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeDatetimeTZ, cxoDbTypeTimestampLTZ)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeDatetimeTZ, cxoDbTypeTimestampTZ)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochMS, cxoDbTypeDate)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochMS, cxoDbTypeTimestamp)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochMS, cxoDbTypeTimestampLTZ)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochMS, cxoDbTypeTimestampTZ)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochNS, cxoDbTypeDate)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochNS, cxoDbTypeTimestamp)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochNS, cxoDbTypeTimestampLTZ)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochNS, cxoDbTypeTimestampTZ)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochS, cxoDbTypeDate)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochS, cxoDbTypeTimestamp)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochS, cxoDbTypeTimestampLTZ)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochS, cxoDbTypeTimestampTZ)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochUS, cxoDbTypeDate)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochUS, cxoDbTypeTimestamp)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochUS, cxoDbTypeTimestampLTZ)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeEpochUS, cxoDbTypeTimestampTZ)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeNumber, cxoDbTypeBinaryDouble)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeNumber, cxoDbTypeBinaryFloat)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeNumber, cxoDbTypeBinaryInteger)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeNumber, cxoDbTypeNumber)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeRowid, cxoDbTypeRowid)
+    CXO_ASSOCIATE_DB_TYPE(cxoApiTypeScaledInt, cxoDbTypeNumber)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeString, cxoDbTypeChar)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeString, cxoDbTypeClob)
     CXO_ASSOCIATE_DB_TYPE(cxoApiTypeString, cxoDbTypeLong)
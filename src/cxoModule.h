@@ -25,12 +25,17 @@
 // define macro for clearing buffers
 #define cxoBuffer_clear(buf)            Py_CLEAR((buf)->obj)
 
+// size of the space within buffers used for numbers formatted as text
+#define CXO_BUFFER_NUMBER_SIZE          32
+
 
 //-----------------------------------------------------------------------------
 // Forward Declarations
 //-----------------------------------------------------------------------------
 typedef struct cxoApiType cxoApiType;
 typedef struct cxoBuffer cxoBuffer;
+typedef struct cxoColumnData cxoColumnData;
+typedef struct cxoColumnarWriter cxoColumnarWriter;
 typedef struct cxoConnection cxoConnection;
 typedef struct cxoCursor cxoCursor;
 typedef struct cxoDbType cxoDbType;
@@ -48,6 +53,7 @@ typedef struct cxoObject cxoObject;
 typedef struct cxoObjectAttr cxoObjectAttr;
 typedef struct cxoObjectType cxoObjectType;
 typedef struct cxoQueue cxoQueue;
+typedef struct cxoSerializeBuffer cxoSerializeBuffer;
 typedef struct cxoSessionPool cxoSessionPool;
 typedef struct cxoSodaCollection cxoSodaCollection;
 typedef struct cxoSodaDatabase cxoSodaDatabase;
@@ -76,6 +82,7 @@ extern PyObject *cxoNotSupportedErrorException;
 
 // type objects
 extern PyTypeObject cxoPyTypeApiType;
+extern PyTypeObject cxoPyTypeColumnData;
 extern PyTypeObject cxoPyTypeConnection;
 extern PyTypeObject cxoPyTypeCursor;
 extern PyTypeObject cxoPyTypeDbType;
@@ -92,6 +99,7 @@ extern PyTypeObject cxoPyTypeMessageTable;
 extern PyTypeObject cxoPyTypeObject;
 extern PyTypeObject cxoPyTypeObjectAttr;
 extern PyTypeObject cxoPyTypeObjectType;
+extern PyTypeObject cxoPyTypePreparedStatement;
 extern PyTypeObject cxoPyTypeQueue;
 extern PyTypeObject cxoPyTypeSessionPool;
 extern PyTypeObject cxoPyTypeSodaCollection;
@@ -136,8 +144,14 @@ extern cxoDbType *cxoDbTypeVarchar;
 // database API types
 extern cxoApiType *cxoApiTypeBinary;
 extern cxoApiType *cxoApiTypeDatetime;
+extern cxoApiType *cxoApiTypeDatetimeTZ;
+extern cxoApiType *cxoApiTypeEpochMS;
+extern cxoApiType *cxoApiTypeEpochNS;
+extern cxoApiType *cxoApiTypeEpochS;
+extern cxoApiType *cxoApiTypeEpochUS;
 extern cxoApiType *cxoApiTypeNumber;
 extern cxoApiType *cxoApiTypeRowid;
+extern cxoApiType *cxoApiTypeScaledInt;
 extern cxoApiType *cxoApiTypeString;
 
 // JSON dump and load functions for use with SODA
@@ -166,6 +180,10 @@ typedef enum {
     CXO_TRANSFORM_DATE,
     CXO_TRANSFORM_DATETIME,
     CXO_TRANSFORM_DECIMAL,
+    CXO_TRANSFORM_EPOCH_MS,
+    CXO_TRANSFORM_EPOCH_NS,
+    CXO_TRANSFORM_EPOCH_S,
+    CXO_TRANSFORM_EPOCH_US,
     CXO_TRANSFORM_FIXED_CHAR,
     CXO_TRANSFORM_FIXED_NCHAR,
     CXO_TRANSFORM_FLOAT,
@@ -179,11 +197,13 @@ typedef enum {
     CXO_TRANSFORM_NSTRING,
     CXO_TRANSFORM_OBJECT,
     CXO_TRANSFORM_ROWID,
+    CXO_TRANSFORM_SCALED_INT,
     CXO_TRANSFORM_STRING,
     CXO_TRANSFORM_TIMEDELTA,
     CXO_TRANSFORM_TIMESTAMP,
     CXO_TRANSFORM_TIMESTAMP_LTZ,
     CXO_TRANSFORM_TIMESTAMP_TZ,
+    CXO_TRANSFORM_TIMESTAMP_TZ_AWARE,
     CXO_TRANSFORM_UNSUPPORTED
 } cxoTransformNum;
 
@@ -203,6 +223,17 @@ struct cxoBuffer {
     uint32_t numCharacters;
     uint32_t size;
     PyObject *obj;
+    char number[CXO_BUFFER_NUMBER_SIZE];
+};
+
+struct cxoColumnData {
+    PyObject_HEAD
+    PyObject *name;
+    PyObject *kind;
+    PyObject *data;
+    PyObject *nulls;
+    PyObject *offsets;
+    int scale;
 };
 
 struct cxoError {
@@ -224,6 +255,22 @@ struct cxoConnection {
     PyObject *dsn;
     PyObject *version;
     PyObject *tag;
+    PyObject *tunedArraySizes;
+    PyObject *resultCache;
+    PyObject *resultCacheQueryIds;
+    PyObject *resultCacheQueryKeys;
+    cxoSubscr *resultCacheSubscr;
+    uint32_t resultCacheSize;
+    uint32_t resultCacheTimeout;
+    unsigned long resultCacheGeneration;
+    PyObject *groupCommitFutures;
+    PyThread_type_lock groupCommitLock;
+    PyThread_type_lock groupCommitInProgressLock;
+    uint32_t groupCommitWindow;
+    uint32_t groupCommitSize;
+    int groupCommitThreadActive;
+    int groupCommitWakePending;
+    int groupCommitInProgress;
     dpiEncodingInfo encodingInfo;
     int autocommit;
 };
@@ -243,12 +290,23 @@ struct cxoCursor {
     uint32_t arraySize;
     uint32_t bindArraySize;
     uint32_t fetchArraySize;
+    uint32_t adaptiveFetchSize;
+    uint32_t adaptiveDefineSize;
+    uint32_t *adaptiveSizes;
+    uint32_t numAdaptiveSizes;
+    uint32_t tuneRoundTrips;
+    uint64_t tuneNumRows;
+    double tuneElapsed;
     int setInputSizes;
     uint64_t rowCount;
     uint32_t fetchBufferRowIndex;
     uint32_t numRowsInFetchBuffer;
     int moreRowsToFetch;
     char isScrollable;
+    char isPreparedScrollable;
+    char autoArraySize;
+    char fixedStatement;
+    cxoTransformNum epochTransformNum;
     int fixupRefCursor;
     int isOpen;
 };
@@ -314,6 +372,9 @@ struct cxoMessageTable {
     PyObject *name;
     PyObject *rows;
     dpiOpCode operation;
+    const char *encoding;
+    uint32_t numRows;
+    dpiSubscrMessageRow *rowData;
 };
 
 struct cxoMsgProps {
@@ -364,21 +425,31 @@ struct cxoQueue {
     cxoObjectType *payloadType;
 };
 
+struct cxoSerializeBuffer {
+    char *ptr;
+    size_t length;
+    size_t allocated;
+    size_t numRowsOffset;
+};
+
 struct cxoSessionPool {
     PyObject_HEAD
     dpiPool *handle;
     uint32_t minSessions;
     uint32_t maxSessions;
     uint32_t sessionIncrement;
+    uint32_t warmupThreads;
     uint32_t cacheSize;
     dpiEncodingInfo encodingInfo;
     int homogeneous;
     int externalAuth;
+    int threaded;
     PyObject *username;
     PyObject *dsn;
     PyObject *name;
     PyObject *sessionCallback;
     PyTypeObject *connectionType;
+    struct cxoPoolWarmup *warmup;
 };
 
 struct cxoSodaCollection {
@@ -435,6 +506,21 @@ struct cxoSubscr {
     uint32_t groupingValue;
     uint8_t groupingType;
     uint64_t id;
+    uint32_t bufferSize;
+    uint32_t coalesceWindow;
+    dpiSubscrMessage **pendingMessages;
+    dpiSubscrMessage **deliveryMessages;
+    uint32_t numPendingMessages;
+    unsigned long long droppedEvents;
+    unsigned long long coalescedEvents;
+    PyThread_type_lock bufferLock;
+    PyThread_type_lock eventLock;
+    PyThread_type_lock stopLock;
+    PyThread_type_lock threadDoneLock;
+    unsigned long deliveryThreadId;
+    int stopping;
+    int threadDone;
+    int deallocating;
 };
 
 struct cxoVar {
@@ -455,19 +541,32 @@ struct cxoVar {
     cxoTransformNum transformNum;
     dpiNativeTypeNum nativeTypeNum;
     cxoDbType *dbType;
+    int8_t scale;
 };
 
 
 //-----------------------------------------------------------------------------
 // Functions
 //-----------------------------------------------------------------------------
+int cxoBuffer_fromNumber(cxoBuffer *buf, PyObject *obj, const char *encoding);
 int cxoBuffer_fromObject(cxoBuffer *buf, PyObject *obj, const char *encoding);
 int cxoBuffer_init(cxoBuffer *buf);
 
+PyObject *cxoColumnar_finish(cxoColumnarWriter *writer);
+void cxoColumnar_freeWriter(cxoColumnarWriter *writer);
+cxoColumnarWriter *cxoColumnar_newWriter(cxoCursor *cursor);
+PyObject *cxoColumnar_open(PyObject *obj);
+int cxoColumnar_writeRow(cxoColumnarWriter *writer, cxoCursor *cursor,
+        uint32_t pos);
+
+int cxoConnection_failGroupCommit(cxoConnection *conn, const char *message);
 int cxoConnection_getSodaFlags(cxoConnection *conn, uint32_t *flags);
 int cxoConnection_isConnected(cxoConnection *conn);
+void cxoConnection_invalidateResultCache(cxoConnection *conn,
+        cxoSubscr *subscr, dpiSubscrMessage *message);
 
 int cxoCursor_performBind(cxoCursor *cursor);
+int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns);
 int cxoCursor_setBindVariables(cxoCursor *cursor, PyObject *parameters,
         unsigned numElements, unsigned arrayPos, int deferTypeAssignment);
 
@@ -492,12 +591,16 @@ PyObject *cxoLob_new(cxoConnection *connection, cxoDbType *dbType,
 
 cxoMsgProps *cxoMsgProps_new(cxoConnection*, dpiMsgProps *handle);
 
+int cxoObject_extendRows(cxoObject *obj, PyObject *rows);
 int cxoObject_internalExtend(cxoObject *obj, PyObject *sequence);
 PyObject *cxoObject_new(cxoObjectType *objectType, dpiObject *handle);
+int cxoObject_setAttributes(cxoObject *obj, PyObject *value);
 
 cxoObjectAttr *cxoObjectAttr_new(cxoConnection *connection,
         dpiObjectAttr *handle);
 
+PyObject *cxoObjectType_createObject(cxoObjectType *objType,
+        PyObject *value);
 cxoObjectType *cxoObjectType_new(cxoConnection *connection,
         dpiObjectType *handle);
 cxoObjectType *cxoObjectType_newByName(cxoConnection *connection,
@@ -505,6 +608,13 @@ cxoObjectType *cxoObjectType_newByName(cxoConnection *connection,
 
 cxoQueue *cxoQueue_new(cxoConnection *conn, dpiQueue *handle);
 
+PyObject *cxoSerialize_finish(cxoSerializeBuffer *buf, uint32_t numRows);
+void cxoSerialize_free(cxoSerializeBuffer *buf);
+PyObject *cxoSerialize_load(PyObject *obj);
+int cxoSerialize_writeHeader(cxoSerializeBuffer *buf, cxoCursor *cursor);
+int cxoSerialize_writeRow(cxoSerializeBuffer *buf, cxoCursor *cursor,
+        uint32_t pos);
+
 cxoSodaCollection *cxoSodaCollection_new(cxoSodaDatabase *db,
         dpiSodaColl *handle);
 
@@ -518,6 +628,8 @@ cxoSodaDocCursor *cxoSodaDocCursor_new(cxoSodaDatabase *db,
 cxoSodaOperation *cxoSodaOperation_new(cxoSodaCollection *collection);
 
 void cxoSubscr_callback(cxoSubscr *subscr, dpiSubscrMessage *message);
+int cxoSubscr_startDelivery(cxoSubscr *subscr);
+void cxoSubscr_stopDelivery(cxoSubscr *subscr);
 
 PyObject *cxoTransform_dateFromTicks(PyObject *args);
 int cxoTransform_fromPython(cxoTransformNum transformNum,
@@ -525,6 +637,7 @@ int cxoTransform_fromPython(cxoTransformNum transformNum,
         dpiDataBuffer *dbValue, cxoBuffer *buffer, const char *encoding,
         const char *nencoding, cxoVar *var, uint32_t arrayPos);
 uint32_t cxoTransform_getDefaultSize(cxoTransformNum transformNum);
+int64_t cxoTransform_getEpochUnitsPerSecond(cxoTransformNum transformNum);
 cxoTransformNum cxoTransform_getNumFromDataTypeInfo(dpiDataTypeInfo *info);
 cxoTransformNum cxoTransform_getNumFromPythonValue(PyObject *value,
         int plsql);
@@ -533,6 +646,7 @@ int cxoTransform_getNumFromType(PyObject *type, cxoTransformNum *transformNum,
 int cxoTransform_getNumFromValue(PyObject *value, int *isArray,
         Py_ssize_t *size, Py_ssize_t *numElements, int plsql,
         cxoTransformNum *transformNum);
+int cxoTransform_getScaledInt(dpiBytes *bytes, int8_t scale, int64_t *value);
 void cxoTransform_getTypeInfo(cxoTransformNum transformNum,
         dpiOracleTypeNum *oracleTypeNum, dpiNativeTypeNum *nativeTypeNum);
 int cxoTransform_init(void);
@@ -544,12 +658,20 @@ PyObject *cxoTransform_toPython(cxoTransformNum transformNum,
 PyObject *cxoUtils_formatString(const char *format, PyObject *args);
 const char *cxoUtils_getAdjustedEncoding(const char *encoding);
 int cxoUtils_getBooleanValue(PyObject *obj, int defaultValue, int *value);
+int64_t cxoUtils_getDaysSinceEpoch(int year, int month, int day);
+int cxoUtils_getEpochTime(dpiTimestamp *timestamp, int64_t unitsPerSecond,
+        int useTimeZone, int64_t *value);
 int cxoUtils_getModuleAndName(PyTypeObject *type, PyObject **module,
         PyObject **name);
+double cxoUtils_getMonotonicTime(void);
 int cxoUtils_initializeDPI(void);
+int cxoUtils_isAsciiCompatible(const char *encoding);
 int cxoUtils_processJsonArg(PyObject *arg, cxoBuffer *buffer);
 int cxoUtils_processSodaDocArg(cxoSodaDatabase *db, PyObject *arg,
         dpiSodaDoc **handle);
+int cxoUtils_setEpochTime(int64_t value, int64_t unitsPerSecond,
+        dpiTimestamp *timestamp);
+void cxoUtils_sleep(uint32_t milliseconds);
 
 int cxoVar_bind(cxoVar *var, cxoCursor *cursor, PyObject *name, uint32_t pos);
 int cxoVar_check(PyObject *object);
@@ -36,6 +36,8 @@ static PyObject *cxoObject_getPrevIndex(cxoObject*, PyObject*);
 static PyObject *cxoObject_getSize(cxoObject*, PyObject*);
 static PyObject *cxoObject_setElement(cxoObject*, PyObject*);
 static PyObject *cxoObject_trim(cxoObject*, PyObject*);
+static PyObject *cxoObject_toDict(cxoObject*, PyObject*, PyObject*);
+static PyObject *cxoObject_handleToNative(cxoObjectType*, dpiObject*, int);
 
 
 //-----------------------------------------------------------------------------
@@ -57,6 +59,8 @@ static PyMethodDef cxoObjectMethods[] = {
     { "setelement", (PyCFunction) cxoObject_setElement, METH_VARARGS },
     { "size", (PyCFunction) cxoObject_getSize, METH_NOARGS },
     { "trim", (PyCFunction) cxoObject_trim, METH_VARARGS },
+    { "todict", (PyCFunction) cxoObject_toDict,
+            METH_VARARGS | METH_KEYWORDS },
     { NULL, NULL }
 };
 
@@ -325,6 +329,141 @@ int cxoObject_internalExtend(cxoObject *obj, PyObject *sequence)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoObject_buildValue()
+//   Return the value to store in an attribute or element of the given object
+// type. Dictionaries, tuples and lists are used to build a new object of that
+// type; all other values are returned unchanged.
+//-----------------------------------------------------------------------------
+static PyObject *cxoObject_buildValue(cxoObjectType *objType, PyObject *value)
+{
+    if (objType && (PyDict_Check(value) || PyTuple_Check(value) ||
+            PyList_Check(value)))
+        return cxoObjectType_createObject(objType, value);
+    Py_INCREF(value);
+    return value;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObject_setAttributes()
+//   Set the attributes of the object from a dictionary, keyed by attribute
+// name, or from a sequence of values in the order in which the attributes are
+// defined by the type. Nested objects and collections may themselves be
+// specified as dictionaries and sequences.
+//-----------------------------------------------------------------------------
+int cxoObject_setAttributes(cxoObject *obj, PyObject *value)
+{
+    PyObject *fastSequence, *name, *attrValue, *upperName;
+    cxoObjectAttr *attribute;
+    Py_ssize_t pos, size;
+    int status;
+
+    // values specified by name; names are matched exactly first and then in
+    // upper case, which is how unquoted names are stored by the database
+    if (PyDict_Check(value)) {
+        pos = 0;
+        while (PyDict_Next(value, &pos, &name, &attrValue)) {
+            attribute = (cxoObjectAttr*) PyDict_GetItem(
+                    obj->objectType->attributesByName, name);
+            if (!attribute && PyUnicode_Check(name)) {
+                upperName = PyObject_CallMethod(name, "upper", NULL);
+                if (!upperName)
+                    return -1;
+                attribute = (cxoObjectAttr*) PyDict_GetItem(
+                        obj->objectType->attributesByName, upperName);
+                Py_DECREF(upperName);
+            }
+            if (!attribute) {
+                PyErr_Format(PyExc_AttributeError,
+                        "type %U.%U has no attribute %R",
+                        obj->objectType->schema, obj->objectType->name, name);
+                return -1;
+            }
+            attrValue = cxoObject_buildValue(attribute->objectType,
+                    attrValue);
+            if (!attrValue)
+                return -1;
+            status = cxoObject_setAttributeValue(obj, attribute, attrValue);
+            Py_DECREF(attrValue);
+            if (status < 0)
+                return -1;
+        }
+        return 0;
+    }
+
+    // values specified by position
+    fastSequence = PySequence_Fast(value,
+            "expecting dictionary or sequence of attribute values");
+    if (!fastSequence)
+        return -1;
+    size = PySequence_Fast_GET_SIZE(fastSequence);
+    if (size > PyList_GET_SIZE(obj->objectType->attributes)) {
+        Py_DECREF(fastSequence);
+        PyErr_Format(PyExc_TypeError,
+                "type %U.%U has only %zd attributes", obj->objectType->schema,
+                obj->objectType->name,
+                PyList_GET_SIZE(obj->objectType->attributes));
+        return -1;
+    }
+    for (pos = 0; pos < size; pos++) {
+        attribute = (cxoObjectAttr*)
+                PyList_GET_ITEM(obj->objectType->attributes, pos);
+        attrValue = cxoObject_buildValue(attribute->objectType,
+                PySequence_Fast_GET_ITEM(fastSequence, pos));
+        if (!attrValue) {
+            Py_DECREF(fastSequence);
+            return -1;
+        }
+        status = cxoObject_setAttributeValue(obj, attribute, attrValue);
+        Py_DECREF(attrValue);
+        if (status < 0) {
+            Py_DECREF(fastSequence);
+            return -1;
+        }
+    }
+    Py_DECREF(fastSequence);
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObject_extendRows()
+//   Extend the collection by appending each of the items in the sequence. If
+// the elements of the collection are objects, each item may be specified as a
+// dictionary or sequence of attribute values.
+//-----------------------------------------------------------------------------
+int cxoObject_extendRows(cxoObject *obj, PyObject *rows)
+{
+    PyObject *fastSequence, *element;
+    Py_ssize_t size, i;
+    int status;
+
+    fastSequence = PySequence_Fast(rows, "expecting sequence");
+    if (!fastSequence)
+        return -1;
+    size = PySequence_Fast_GET_SIZE(fastSequence);
+    for (i = 0; i < size; i++) {
+        element = cxoObject_buildValue(obj->objectType->elementObjectType,
+                PySequence_Fast_GET_ITEM(fastSequence, i));
+        if (!element) {
+            Py_DECREF(fastSequence);
+            return -1;
+        }
+        status = cxoObject_internalAppend(obj, element);
+        Py_DECREF(element);
+        if (status < 0) {
+            Py_DECREF(fastSequence);
+            return -1;
+        }
+    }
+    Py_DECREF(fastSequence);
+
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoObject_append()
 //   Append an item to the collection.
@@ -683,3 +822,173 @@ static PyObject *cxoObject_trim(cxoObject *obj, PyObject *args)
         return cxoError_raiseAndReturnNull();
     Py_RETURN_NONE;
 }
+
+
+//-----------------------------------------------------------------------------
+// cxoObject_initNativeData()
+//   Determine the native type used to retrieve a value with the given
+// transform and prepare the data structure for it. Numbers retrieved as bytes
+// are placed in the supplied buffer.
+//-----------------------------------------------------------------------------
+static int cxoObject_initNativeData(cxoTransformNum transformNum,
+        dpiOracleTypeNum typeNum, dpiNativeTypeNum *nativeTypeNum,
+        dpiData *data, char *buffer, uint32_t bufferLength)
+{
+    dpiOracleTypeNum oracleTypeNum;
+    char message[120];
+
+    if (transformNum == CXO_TRANSFORM_UNSUPPORTED) {
+        snprintf(message, sizeof(message), "Oracle type %d not supported.",
+                typeNum);
+        cxoError_raiseFromString(cxoNotSupportedErrorException, message);
+        return -1;
+    }
+    cxoTransform_getTypeInfo(transformNum, &oracleTypeNum, nativeTypeNum);
+    if (oracleTypeNum == DPI_ORACLE_TYPE_NUMBER &&
+            *nativeTypeNum == DPI_NATIVE_TYPE_BYTES) {
+        data->value.asBytes.ptr = buffer;
+        data->value.asBytes.length = bufferLength;
+        data->value.asBytes.encoding = NULL;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObject_dataToNative()
+//   Convert a value retrieved from an object to Python. Objects are converted
+// to dictionaries and collections to lists directly from the handle returned
+// by ODPI-C, without creating intermediate Python objects, if requested.
+//-----------------------------------------------------------------------------
+static PyObject *cxoObject_dataToNative(cxoConnection *connection,
+        cxoTransformNum transformNum, cxoObjectType *objType, dpiData *data,
+        int recursive)
+{
+    PyObject *result;
+
+    if (data->isNull)
+        Py_RETURN_NONE;
+    if (recursive && objType) {
+        result = cxoObject_handleToNative(objType, data->value.asObject, 1);
+        dpiObject_release(data->value.asObject);
+        return result;
+    }
+    return cxoTransform_toPython(transformNum, connection, objType,
+            &data->value, NULL);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObject_handleToNative()
+//   Convert the object with the given handle and type to a dictionary keyed
+// by attribute name or, for collections, to a list of elements in index
+// order. The attribute information cached on the object type is used so that
+// each value is retrieved with a single call to ODPI-C.
+//-----------------------------------------------------------------------------
+static PyObject *cxoObject_handleToNative(cxoObjectType *objType,
+        dpiObject *handle, int recursive)
+{
+    char numberAsStringBuffer[200];
+    dpiNativeTypeNum nativeTypeNum;
+    cxoObjectAttr *attribute;
+    PyObject *result, *value;
+    int32_t index, nextIndex;
+    Py_ssize_t i;
+    dpiData data;
+    int exists;
+
+    // collections are converted to lists; the buffer for numbers retrieved
+    // as bytes is prepared again for each element since its length is
+    // replaced by the length of the value retrieved
+    if (objType->isCollection) {
+        result = PyList_New(0);
+        if (!result)
+            return NULL;
+        if (dpiObject_getFirstIndex(handle, &index, &exists) < 0) {
+            Py_DECREF(result);
+            return cxoError_raiseAndReturnNull();
+        }
+        while (exists) {
+            if (cxoObject_initNativeData(objType->elementTransformNum,
+                    objType->elementOracleTypeNum, &nativeTypeNum, &data,
+                    numberAsStringBuffer, sizeof(numberAsStringBuffer)) < 0) {
+                Py_DECREF(result);
+                return NULL;
+            }
+            if (dpiObject_getElementValueByIndex(handle, index, nativeTypeNum,
+                    &data) < 0) {
+                Py_DECREF(result);
+                return cxoError_raiseAndReturnNull();
+            }
+            value = cxoObject_dataToNative(objType->connection,
+                    objType->elementTransformNum, objType->elementObjectType,
+                    &data, recursive);
+            if (!value || PyList_Append(result, value) < 0) {
+                Py_XDECREF(value);
+                Py_DECREF(result);
+                return NULL;
+            }
+            Py_DECREF(value);
+            if (dpiObject_getNextIndex(handle, index, &nextIndex,
+                    &exists) < 0) {
+                Py_DECREF(result);
+                return cxoError_raiseAndReturnNull();
+            }
+            index = nextIndex;
+        }
+        return result;
+    }
+
+    // other objects are converted to dictionaries
+    result = PyDict_New();
+    if (!result)
+        return NULL;
+    for (i = 0; i < PyList_GET_SIZE(objType->attributes); i++) {
+        attribute = (cxoObjectAttr*) PyList_GET_ITEM(objType->attributes, i);
+        if (cxoObject_initNativeData(attribute->transformNum,
+                attribute->oracleTypeNum, &nativeTypeNum, &data,
+                numberAsStringBuffer, sizeof(numberAsStringBuffer)) < 0) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        if (dpiObject_getAttributeValue(handle, attribute->handle,
+                nativeTypeNum, &data) < 0) {
+            Py_DECREF(result);
+            return cxoError_raiseAndReturnNull();
+        }
+        value = cxoObject_dataToNative(objType->connection,
+                attribute->transformNum, attribute->objectType, &data,
+                recursive);
+        if (!value || PyDict_SetItem(result, attribute->name, value) < 0) {
+            Py_XDECREF(value);
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObject_toDict()
+//   Return the object as a dictionary keyed by attribute name (or, for
+// collections, as a list of elements). If recursive is true, nested objects
+// and collections are converted as well.
+//-----------------------------------------------------------------------------
+static PyObject *cxoObject_toDict(cxoObject *obj, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "recursive", NULL };
+    PyObject *recursiveObj;
+    int recursive;
+
+    recursiveObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|O", keywordList,
+            &recursiveObj))
+        return NULL;
+    if (cxoUtils_getBooleanValue(recursiveObj, 1, &recursive) < 0)
+        return NULL;
+    return cxoObject_handleToNative(obj->objectType, obj->handle, recursive);
+}
@@ -71,6 +71,7 @@ static int cxoObjectAttr_initialize(cxoObjectAttr *attr,
             connection->encodingInfo.encoding, NULL);
     if (!attr->name)
         return -1;
+    PyUnicode_InternInPlace(&attr->name);
     if (info.typeInfo.objectType) {
         attr->objectType = cxoObjectType_new(connection,
                 info.typeInfo.objectType);
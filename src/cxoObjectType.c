@@ -20,6 +20,8 @@
 static void cxoObjectType_free(cxoObjectType*);
 static PyObject *cxoObjectType_repr(cxoObjectType*);
 static PyObject *cxoObjectType_newObject(cxoObjectType*, PyObject*, PyObject*);
+static PyObject *cxoObjectType_newObjects(cxoObjectType*, PyObject*);
+static PyObject *cxoObjectType_fromRows(cxoObjectType*, PyObject*);
 static PyObject *cxoObjectType_richCompare(cxoObjectType*, PyObject*, int);
 static PyObject *cxoObjectType_getElementType(cxoObjectType*, void*);
 
@@ -30,6 +32,8 @@ static PyObject *cxoObjectType_getElementType(cxoObjectType*, void*);
 static PyMethodDef cxoMethods[] = {
     { "newobject", (PyCFunction) cxoObjectType_newObject,
             METH_VARARGS | METH_KEYWORDS },
+    { "newobjects", (PyCFunction) cxoObjectType_newObjects, METH_O },
+    { "from_rows", (PyCFunction) cxoObjectType_fromRows, METH_O },
     { NULL }
 };
 
@@ -356,3 +360,95 @@ static PyObject *cxoObjectType_newObject(cxoObjectType *objType,
 
     return (PyObject*) obj;
 }
+
+
+//-----------------------------------------------------------------------------
+// cxoObjectType_createObject()
+//   Create a new object of the type and populate it from the given value: for
+// collections, the value is a sequence of elements; for other types, it is a
+// dictionary or sequence of attribute values. If the value is None, the
+// object is left empty.
+//-----------------------------------------------------------------------------
+PyObject *cxoObjectType_createObject(cxoObjectType *objType, PyObject *value)
+{
+    dpiObject *handle;
+    cxoObject *obj;
+    int status;
+
+    // get handle to newly created object
+    if (dpiObjectType_createObject(objType->handle, &handle) < 0)
+        return cxoError_raiseAndReturnNull();
+
+    // create the object
+    obj = (cxoObject*) cxoObject_new(objType, handle);
+    if (!obj) {
+        dpiObject_release(handle);
+        return NULL;
+    }
+
+    // populate the object
+    if (value != Py_None) {
+        if (objType->isCollection)
+            status = cxoObject_extendRows(obj, value);
+        else status = cxoObject_setAttributes(obj, value);
+        if (status < 0) {
+            Py_DECREF(obj);
+            return NULL;
+        }
+    }
+
+    return (PyObject*) obj;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObjectType_newObjects()
+//   Create a list of objects of the type, one for each of the values in the
+// given sequence. Each value is a dictionary or sequence of attribute values
+// (or a sequence of elements for collections).
+//-----------------------------------------------------------------------------
+static PyObject *cxoObjectType_newObjects(cxoObjectType *objType,
+        PyObject *values)
+{
+    PyObject *fastSequence, *result, *obj;
+    Py_ssize_t size, i;
+
+    fastSequence = PySequence_Fast(values, "expecting sequence");
+    if (!fastSequence)
+        return NULL;
+    size = PySequence_Fast_GET_SIZE(fastSequence);
+    result = PyList_New(size);
+    if (!result) {
+        Py_DECREF(fastSequence);
+        return NULL;
+    }
+    for (i = 0; i < size; i++) {
+        obj = cxoObjectType_createObject(objType,
+                PySequence_Fast_GET_ITEM(fastSequence, i));
+        if (!obj) {
+            Py_DECREF(fastSequence);
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, i, obj);
+    }
+    Py_DECREF(fastSequence);
+
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObjectType_fromRows()
+//   Create a new collection of the type containing the given rows. If the
+// elements of the collection are objects, each row may be specified as a
+// dictionary or sequence of attribute values.
+//-----------------------------------------------------------------------------
+static PyObject *cxoObjectType_fromRows(cxoObjectType *objType,
+        PyObject *rows)
+{
+    if (!objType->isCollection)
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "object type is not a collection");
+    return cxoObjectType_createObject(objType, rows);
+}
@@ -0,0 +1,157 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoPreparedStatement.c
+//   Defines the routines for handling prepared statements. A prepared
+// statement is a cursor which is bound to a single statement for its entire
+// lifetime, so the statement handle and the bind and define variables
+// associated with it are retained and reused each time it is executed.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+//-----------------------------------------------------------------------------
+// functions for the Python type "PreparedStatement"
+//-----------------------------------------------------------------------------
+static int cxoPreparedStatement_init(cxoCursor*, PyObject*, PyObject*);
+static PyObject *cxoPreparedStatement_execute(cxoCursor*, PyObject*,
+        PyObject*);
+static PyObject *cxoPreparedStatement_executeMany(cxoCursor*, PyObject*,
+        PyObject*);
+
+
+//-----------------------------------------------------------------------------
+// declaration of methods for Python type "PreparedStatement"
+//-----------------------------------------------------------------------------
+static PyMethodDef cxoPreparedStatementMethods[] = {
+    { "execute", (PyCFunction) cxoPreparedStatement_execute,
+            METH_VARARGS | METH_KEYWORDS },
+    { "executemany", (PyCFunction) cxoPreparedStatement_executeMany,
+            METH_VARARGS | METH_KEYWORDS },
+    { NULL, NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of Python type "PreparedStatement"
+//-----------------------------------------------------------------------------
+PyTypeObject cxoPyTypePreparedStatement = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cx_Oracle.PreparedStatement",
+    .tp_basicsize = sizeof(cxoCursor),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_methods = cxoPreparedStatementMethods,
+    .tp_base = &cxoPyTypeCursor,
+    .tp_init = (initproc) cxoPreparedStatement_init
+};
+
+
+//-----------------------------------------------------------------------------
+// cxoPreparedStatement_init()
+//   Initialize the prepared statement by initializing the cursor and then
+// preparing the statement, which may not be changed afterwards.
+//-----------------------------------------------------------------------------
+static int cxoPreparedStatement_init(cxoCursor *stmt, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "connection", "statement", "tag",
+            "scrollable", NULL };
+    PyObject *connection, *statement, *tag, *scrollable, *cursorArgs;
+    PyObject *result;
+    int status;
+
+    // parse arguments
+    tag = NULL;
+    scrollable = Py_False;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O!O|OO",
+            keywordList, &cxoPyTypeConnection, &connection, &statement, &tag,
+            &scrollable))
+        return -1;
+
+    // initialize the cursor
+    cursorArgs = PyTuple_Pack(2, connection, scrollable);
+    if (!cursorArgs)
+        return -1;
+    status = cxoPyTypeCursor.tp_init((PyObject*) stmt, cursorArgs, NULL);
+    Py_DECREF(cursorArgs);
+    if (status < 0)
+        return -1;
+
+    // prepare the statement
+    if (tag && tag != Py_None)
+        result = PyObject_CallMethod((PyObject*) stmt, "prepare", "OO",
+                statement, tag);
+    else result = PyObject_CallMethod((PyObject*) stmt, "prepare", "O",
+            statement);
+    if (!result)
+        return -1;
+    Py_DECREF(result);
+    stmt->fixedStatement = 1;
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPreparedStatement_callCursorMethod()
+//   Call the cursor method with the given name, passing None as the statement
+// so that the statement that was prepared is used.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPreparedStatement_callCursorMethod(cxoCursor *stmt,
+        const char *name, PyObject *args, PyObject *keywordArgs)
+{
+    PyObject *method, *methodArgs, *arg, *result;
+    Py_ssize_t i, numArgs;
+
+    method = PyObject_GetAttrString((PyObject*) &cxoPyTypeCursor, name);
+    if (!method)
+        return NULL;
+    numArgs = PyTuple_GET_SIZE(args);
+    methodArgs = PyTuple_New(numArgs + 2);
+    if (!methodArgs) {
+        Py_DECREF(method);
+        return NULL;
+    }
+    Py_INCREF(stmt);
+    PyTuple_SET_ITEM(methodArgs, 0, (PyObject*) stmt);
+    Py_INCREF(Py_None);
+    PyTuple_SET_ITEM(methodArgs, 1, Py_None);
+    for (i = 0; i < numArgs; i++) {
+        arg = PyTuple_GET_ITEM(args, i);
+        Py_INCREF(arg);
+        PyTuple_SET_ITEM(methodArgs, i + 2, arg);
+    }
+    result = PyObject_Call(method, methodArgs, keywordArgs);
+    Py_DECREF(methodArgs);
+    Py_DECREF(method);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPreparedStatement_execute()
+//   Execute the prepared statement with the given parameters, which may be
+// supplied as a sequence, a dictionary or keyword arguments.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPreparedStatement_execute(cxoCursor *stmt, PyObject *args,
+        PyObject *keywordArgs)
+{
+    return cxoPreparedStatement_callCursorMethod(stmt, "execute", args,
+            keywordArgs);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPreparedStatement_executeMany()
+//   Execute the prepared statement once for each set of parameters in the
+// given sequence (or the given number of times, if no parameters are
+// required).
+//-----------------------------------------------------------------------------
+static PyObject *cxoPreparedStatement_executeMany(cxoCursor *stmt,
+        PyObject *args, PyObject *keywordArgs)
+{
+    return cxoPreparedStatement_callCursorMethod(stmt, "executemany", args,
+            keywordArgs);
+}
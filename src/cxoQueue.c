@@ -10,24 +10,46 @@
 
 #include "cxoModule.h"
 
+// maximum time (in seconds) that a single dequeue performed by
+// Queue.consume() waits before checking for signals
+#define CXO_QUEUE_CONSUME_MAX_WAIT          1
+
+// interval (in milliseconds) at which Queue.consume() polls for messages when
+// less than a second of the batch latency remains, since the wait time of a
+// dequeue can only be specified in seconds
+#define CXO_QUEUE_CONSUME_POLL_INTERVAL     10
+
 //-----------------------------------------------------------------------------
 // Declaration of functions
 //-----------------------------------------------------------------------------
 static void cxoQueue_free(cxoQueue*);
 static PyObject *cxoQueue_repr(cxoQueue*);
+static PyObject *cxoQueue_consume(cxoQueue*, PyObject*, PyObject*);
 static PyObject *cxoQueue_deqMany(cxoQueue*, PyObject*);
+static PyObject *cxoQueue_deqManyRaw(cxoQueue*, PyObject*, PyObject*);
 static PyObject *cxoQueue_deqOne(cxoQueue*, PyObject*);
 static PyObject *cxoQueue_enqMany(cxoQueue*, PyObject*);
+static PyObject *cxoQueue_enqManyRaw(cxoQueue*, PyObject*, PyObject*);
 static PyObject *cxoQueue_enqOne(cxoQueue*, PyObject*);
+static int cxoQueue_consumeDeliver(cxoQueue*, PyObject*, dpiMsgProps**,
+        uint32_t, int, int*);
+static int cxoQueue_enqRawHelper(cxoQueue*, PyObject*, PyObject*);
+static cxoMsgProps *cxoQueue_newMsgProps(cxoQueue*, dpiMsgProps*);
 
 
 //-----------------------------------------------------------------------------
 // declaration of methods
 //-----------------------------------------------------------------------------
 static PyMethodDef cxoMethods[] = {
+    { "consume", (PyCFunction) cxoQueue_consume,
+            METH_VARARGS | METH_KEYWORDS },
     { "deqMany", (PyCFunction) cxoQueue_deqMany, METH_VARARGS },
+    { "deqManyRaw", (PyCFunction) cxoQueue_deqManyRaw,
+            METH_VARARGS | METH_KEYWORDS },
     { "deqOne", (PyCFunction) cxoQueue_deqOne, METH_NOARGS },
     { "enqMany", (PyCFunction) cxoQueue_enqMany, METH_VARARGS },
+    { "enqManyRaw", (PyCFunction) cxoQueue_enqManyRaw,
+            METH_VARARGS | METH_KEYWORDS },
     { "enqOne", (PyCFunction) cxoQueue_enqOne, METH_VARARGS },
     { NULL }
 };
@@ -146,6 +168,52 @@ static PyObject *cxoQueue_repr(cxoQueue *queue)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoQueue_newMsgProps()
+//   Create a message properties object for a handle returned by a dequeue
+// operation and populate its payload. The handle is released on error.
+//-----------------------------------------------------------------------------
+static cxoMsgProps *cxoQueue_newMsgProps(cxoQueue *queue, dpiMsgProps *handle)
+{
+    uint32_t bufferLength;
+    dpiObject *objHandle;
+    const char *buffer;
+    cxoMsgProps *props;
+    cxoObject *obj;
+
+    // create message property object
+    props = cxoMsgProps_new(queue->conn, handle);
+    if (!props)
+        return NULL;
+
+    // get payload from ODPI-C message property
+    if (dpiMsgProps_getPayload(props->handle, &objHandle, &buffer,
+            &bufferLength) < 0) {
+        Py_DECREF(props);
+        return (cxoMsgProps*) cxoError_raiseAndReturnNull();
+    }
+
+    // store payload on cx_Oracle message property
+    if (objHandle) {
+        obj = (cxoObject*) cxoObject_new(queue->payloadType, objHandle);
+        if (obj && dpiObject_addRef(objHandle) < 0) {
+            cxoError_raiseAndReturnInt();
+            obj->handle = NULL;
+            Py_CLEAR(obj);
+        }
+        props->payload = (PyObject*) obj;
+    } else {
+        props->payload = PyBytes_FromStringAndSize(buffer, bufferLength);
+    }
+    if (!props->payload) {
+        Py_DECREF(props);
+        return NULL;
+    }
+
+    return props;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoQueue_deqHelper()
 //   Helper for dequeuing messages from a queue.
@@ -153,13 +221,9 @@ static PyObject *cxoQueue_repr(cxoQueue *queue)
 int cxoQueue_deqHelper(cxoQueue *queue, uint32_t *numProps,
         cxoMsgProps **props)
 {
-    uint32_t bufferLength, i, j;
     dpiMsgProps **handles;
-    dpiObject *objHandle;
-    const char *buffer;
-    cxoMsgProps *temp;
-    cxoObject *obj;
-    int ok, status;
+    uint32_t i, j;
+    int status;
 
     // use the same array to store the intermediate values provided by ODPI-C;
     // by doing so there is no need to allocate an additional array and any
@@ -175,36 +239,10 @@ int cxoQueue_deqHelper(cxoQueue *queue, uint32_t *numProps,
 
     // create objects that are returned to the user
     for (i = 0; i < *numProps; i++) {
-
-        // create message property object
-        temp = cxoMsgProps_new(queue->conn, handles[i]);
-        ok = (temp) ? 1 : 0;
-        props[i] = temp;
-
-        // get payload from ODPI-C message property
-        if (ok && dpiMsgProps_getPayload(temp->handle, &objHandle, &buffer,
-                &bufferLength) < 0) {
-            cxoError_raiseAndReturnInt();
-            ok = 0;
-        }
-
-        // store payload on cx_Oracle message property
-        if (ok && objHandle) {
-            obj = (cxoObject*) cxoObject_new(queue->payloadType, objHandle);
-            if (obj && dpiObject_addRef(objHandle) < 0) {
-                cxoError_raiseAndReturnInt();
-                obj->handle = NULL;
-                Py_CLEAR(obj);
-                ok = 0;
-            }
-            temp->payload = (PyObject*) obj;
-        } else if (ok) {
-            temp->payload = PyBytes_FromStringAndSize(buffer, bufferLength);
-        }
+        props[i] = cxoQueue_newMsgProps(queue, handles[i]);
 
         // if an error occurred, do some cleanup
-        if (!ok || !temp->payload) {
-            Py_XDECREF(temp);
+        if (!props[i]) {
             for (j = 0; j < i; j++)
                 Py_DECREF(props[j]);
             for (j = i + 1; j < *numProps; j++)
@@ -278,6 +316,329 @@ int cxoQueue_enqHelper(cxoQueue *queue, uint32_t numProps,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoQueue_enqRawHelper()
+//   Helper for enqueuing RAW payloads directly. The message properties handles
+// are created and populated without the need for message property objects;
+// the payloads are either taken from each element of a sequence of objects
+// supporting the buffer protocol or from a single object supporting the
+// buffer protocol, split up using the supplied offsets.
+//-----------------------------------------------------------------------------
+static int cxoQueue_enqRawHelper(cxoQueue *queue, PyObject *payloads,
+        PyObject *offsets)
+{
+    Py_ssize_t numProps, numCreated, i, startOffset, endOffset;
+    dpiMsgProps **handles;
+    PyObject *seq, *item;
+    Py_buffer view;
+    int status;
+
+    // acquire the payload buffer (or sequence of payloads) and the number of
+    // messages that are going to be enqueued
+    view.obj = NULL;
+    if (offsets) {
+        if (PyObject_GetBuffer(payloads, &view, PyBUF_SIMPLE) < 0)
+            return -1;
+        seq = PySequence_Fast(offsets, "expecting sequence of offsets");
+        if (!seq) {
+            PyBuffer_Release(&view);
+            return -1;
+        }
+        numProps = PySequence_Fast_GET_SIZE(seq) - 1;
+    } else {
+        seq = PySequence_Fast(payloads, "expecting sequence of payloads");
+        if (!seq)
+            return -1;
+        numProps = PySequence_Fast_GET_SIZE(seq);
+    }
+
+    // zero messages means nothing to do
+    if (numProps <= 0) {
+        Py_DECREF(seq);
+        if (view.obj)
+            PyBuffer_Release(&view);
+        return 0;
+    }
+
+    // create and populate a message properties handle for each payload
+    handles = PyMem_Malloc(numProps * sizeof(dpiMsgProps*));
+    if (!handles) {
+        PyErr_NoMemory();
+        Py_DECREF(seq);
+        if (view.obj)
+            PyBuffer_Release(&view);
+        return -1;
+    }
+    status = 0;
+    numCreated = 0;
+    for (i = 0; i < numProps; i++) {
+        if (dpiConn_newMsgProps(queue->conn->handle, &handles[i]) < 0) {
+            status = cxoError_raiseAndReturnInt();
+            break;
+        }
+        numCreated++;
+        if (offsets) {
+            startOffset = PyLong_AsSsize_t(PySequence_Fast_GET_ITEM(seq, i));
+            endOffset = PyLong_AsSsize_t(PySequence_Fast_GET_ITEM(seq,
+                    i + 1));
+            if (PyErr_Occurred()) {
+                status = -1;
+            } else if (startOffset < 0 || endOffset < startOffset ||
+                    endOffset > view.len) {
+                cxoError_raiseFromString(cxoProgrammingErrorException,
+                        "offsets must be ascending and within the buffer");
+                status = -1;
+            } else if (dpiMsgProps_setPayloadBytes(handles[i],
+                    (char*) view.buf + startOffset,
+                    (uint32_t) (endOffset - startOffset)) < 0) {
+                status = cxoError_raiseAndReturnInt();
+            }
+        } else {
+            item = PySequence_Fast_GET_ITEM(seq, i);
+            if (PyObject_GetBuffer(item, &view, PyBUF_SIMPLE) < 0) {
+                status = -1;
+            } else {
+                if (dpiMsgProps_setPayloadBytes(handles[i], view.buf,
+                        (uint32_t) view.len) < 0)
+                    status = cxoError_raiseAndReturnInt();
+                PyBuffer_Release(&view);
+                view.obj = NULL;
+            }
+        }
+        if (status < 0)
+            break;
+    }
+    Py_DECREF(seq);
+    if (view.obj)
+        PyBuffer_Release(&view);
+
+    // perform enqueue
+    if (status == 0) {
+        Py_BEGIN_ALLOW_THREADS
+        status = dpiQueue_enqMany(queue->handle, (uint32_t) numProps,
+                handles);
+        Py_END_ALLOW_THREADS
+        if (status < 0)
+            cxoError_raiseAndReturnInt();
+    }
+
+    // release the message properties handles
+    for (i = 0; i < numCreated; i++)
+        dpiMsgProps_release(handles[i]);
+    PyMem_Free(handles);
+    return (status < 0) ? -1 : 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoQueue_consumeDeliver()
+//   Pass a batch of messages dequeued by cxoQueue_consume() to the callback
+// and commit the transaction afterwards, if applicable. If the list of
+// messages cannot be created, the remaining handles are released. The stop
+// flag is set if the callback returns False.
+//-----------------------------------------------------------------------------
+static int cxoQueue_consumeDeliver(cxoQueue *queue, PyObject *callback,
+        dpiMsgProps **handles, uint32_t numInBatch, int autocommit, int *stop)
+{
+    PyObject *list, *result;
+    cxoMsgProps *props;
+    uint32_t i;
+    int status;
+
+    // create the list of messages that is passed to the callback; if an
+    // error occurs, the remaining handles are released
+    list = PyList_New(numInBatch);
+    for (i = 0; i < numInBatch; i++) {
+        if (!list) {
+            dpiMsgProps_release(handles[i]);
+            continue;
+        }
+        props = cxoQueue_newMsgProps(queue, handles[i]);
+        if (!props) {
+            Py_CLEAR(list);
+            continue;
+        }
+        PyList_SET_ITEM(list, i, (PyObject*) props);
+    }
+    if (!list)
+        return -1;
+
+    // invoke the callback
+    result = PyObject_CallFunctionObjArgs(callback, list, NULL);
+    Py_DECREF(list);
+    if (!result)
+        return -1;
+    *stop = (result == Py_False);
+    Py_DECREF(result);
+
+    // commit the batch, if applicable
+    if (autocommit) {
+        Py_BEGIN_ALLOW_THREADS
+        status = dpiConn_commit(queue->conn->handle);
+        Py_END_ALLOW_THREADS
+        if (status < 0)
+            return cxoError_raiseAndReturnInt();
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoQueue_consume()
+//   Dequeue messages from the queue in batches and pass each batch to the
+// supplied callback as a list of message property objects. The GIL is only
+// released while messages are being dequeued. Each dequeue waits for at most
+// CXO_QUEUE_CONSUME_MAX_WAIT seconds so that signals (such as Ctrl-C) are
+// noticed even when waiting forever; when less than a second of the batch
+// latency (in milliseconds) remains, the queue is polled instead. Consumption
+// continues until no messages arrive within the maximum wait time or the
+// callback returns False. If an error occurs while a batch is being
+// collected, the messages already dequeued are passed to the callback before
+// the error is raised. The number of messages consumed is returned.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueue_consume(cxoQueue *queue, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "callback", "batchSize", "maxWait",
+            "maxBatchLatency", "autocommit", NULL };
+    uint32_t batchSize, maxWait, maxBatchLatency, origWait, numInBatch;
+    uint32_t numProps, wait, waited;
+    PyObject *callback, *errorType, *errorValue, *errorTraceback;
+    unsigned long long numConsumed = 0;
+    dpiDeqOptions *deqOptionsHandle;
+    double batchStart = 0, remaining;
+    int autocommit, status, stop;
+    PyObject *autocommitObj;
+    dpiMsgProps **handles;
+
+    // parse arguments
+    batchSize = 100;
+    maxWait = DPI_DEQ_WAIT_FOREVER;
+    maxBatchLatency = 1000;
+    autocommitObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|IIIO", keywordList,
+            &callback, &batchSize, &maxWait, &maxBatchLatency,
+            &autocommitObj))
+        return NULL;
+    if (cxoUtils_getBooleanValue(autocommitObj, 0, &autocommit) < 0)
+        return NULL;
+    if (!PyCallable_Check(callback)) {
+        PyErr_SetString(PyExc_TypeError, "expecting callable");
+        return NULL;
+    }
+    if (batchSize == 0) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "batch size must be greater than zero");
+        return NULL;
+    }
+
+    // the wait option is adjusted during consumption so retain the original
+    // value in order to restore it afterwards
+    deqOptionsHandle = ((cxoDeqOptions*) queue->deqOptions)->handle;
+    if (dpiDeqOptions_getWait(deqOptionsHandle, &origWait) < 0)
+        return cxoError_raiseAndReturnNull();
+    handles = PyMem_Malloc(batchSize * sizeof(dpiMsgProps*));
+    if (!handles)
+        return PyErr_NoMemory();
+
+    // process batches until the maximum wait time expires without any
+    // messages being dequeued or the callback requests that processing stop
+    status = 0;
+    stop = 0;
+    waited = 0;
+    numInBatch = 0;
+    while (!stop) {
+
+        // determine how long to wait; before the first message of a batch
+        // has arrived, the maximum wait time applies; afterwards, the
+        // remaining batch latency applies and the queue is polled once less
+        // than a second remains
+        remaining = 0;
+        if (numInBatch == 0) {
+            wait = CXO_QUEUE_CONSUME_MAX_WAIT;
+            if (maxWait != DPI_DEQ_WAIT_FOREVER && maxWait - waited < wait)
+                wait = maxWait - waited;
+        } else {
+            remaining = maxBatchLatency -
+                    (cxoUtils_getMonotonicTime() - batchStart);
+            wait = (remaining >= 1000.0) ? CXO_QUEUE_CONSUME_MAX_WAIT : 0;
+        }
+
+        // dequeue messages without holding the GIL; when polling and no
+        // messages are available, sleep briefly before polling again
+        numProps = batchSize - numInBatch;
+        Py_BEGIN_ALLOW_THREADS
+        status = dpiDeqOptions_setWait(deqOptionsHandle, wait);
+        if (status == 0)
+            status = dpiQueue_deqMany(queue->handle, &numProps,
+                    &handles[numInBatch]);
+        if (status == 0 && numProps == 0 && wait == 0 && remaining > 0)
+            cxoUtils_sleep((remaining < CXO_QUEUE_CONSUME_POLL_INTERVAL) ?
+                    (uint32_t) remaining + 1 :
+                    CXO_QUEUE_CONSUME_POLL_INTERVAL);
+        Py_END_ALLOW_THREADS
+        if (status < 0) {
+            cxoError_raiseAndReturnInt();
+            break;
+        }
+        if (numProps > 0) {
+            if (numInBatch == 0)
+                batchStart = cxoUtils_getMonotonicTime();
+            numInBatch += numProps;
+        } else if (numInBatch == 0) {
+            waited += wait;
+        }
+
+        // check for signals after each wait
+        status = PyErr_CheckSignals();
+        if (status < 0)
+            break;
+
+        // pass the batch to the callback once it is full or the batch
+        // latency has expired
+        if (numInBatch > 0 && (numInBatch == batchSize ||
+                cxoUtils_getMonotonicTime() - batchStart >=
+                maxBatchLatency)) {
+            numConsumed += numInBatch;
+            status = cxoQueue_consumeDeliver(queue, callback, handles,
+                    numInBatch, autocommit, &stop);
+            numInBatch = 0;
+            waited = 0;
+            if (status < 0)
+                break;
+        } else if (numInBatch == 0 && maxWait != DPI_DEQ_WAIT_FOREVER &&
+                waited >= maxWait) {
+            break;
+        }
+
+    }
+
+    // if an error occurred while a batch was being collected, pass the
+    // messages already dequeued to the callback before raising the error
+    if (status < 0 && numInBatch > 0) {
+        PyErr_Fetch(&errorType, &errorValue, &errorTraceback);
+        if (cxoQueue_consumeDeliver(queue, callback, handles, numInBatch,
+                autocommit, &stop) < 0) {
+            Py_XDECREF(errorType);
+            Py_XDECREF(errorValue);
+            Py_XDECREF(errorTraceback);
+        } else PyErr_Restore(errorType, errorValue, errorTraceback);
+    }
+
+    // restore the original wait option
+    PyMem_Free(handles);
+    if (status < 0) {
+        dpiDeqOptions_setWait(deqOptionsHandle, origWait);
+        return NULL;
+    }
+    if (dpiDeqOptions_setWait(deqOptionsHandle, origWait) < 0)
+        return cxoError_raiseAndReturnNull();
+
+    return PyLong_FromUnsignedLongLong(numConsumed);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoQueue_deqMany()
 //   Dequeue a single message to the queue.
@@ -313,6 +674,142 @@ static PyObject *cxoQueue_deqMany(cxoQueue *queue, PyObject *args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoQueue_deqManyRaw()
+//   Dequeue multiple messages from a RAW queue and return the payloads packed
+// into a single bytes object, along with a memoryview of offsets into that
+// buffer (one more than the number of messages dequeued) and, optionally, a
+// list of message ids. No message property objects are created, which means
+// the number of Python objects allocated is independent of the number of
+// messages dequeued.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueue_deqManyRaw(cxoQueue *queue, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "maxMessages", "msgids", NULL };
+    PyObject *payloads, *offsetsBuffer, *offsetsView, *offsets, *msgIds;
+    uint32_t numProps, bufferLength, msgIdLength, i;
+    PyObject *includeMsgIdsObj;
+    unsigned int numPropsFromPython;
+    const char *buffer, *msgId;
+    Py_ssize_t *offsetsPtr;
+    dpiMsgProps **handles;
+    dpiObject *objHandle;
+    int includeMsgIds, ok;
+    char *payloadsPtr;
+
+    // parse arguments
+    includeMsgIdsObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "I|O", keywordList,
+            &numPropsFromPython, &includeMsgIdsObj))
+        return NULL;
+    if (cxoUtils_getBooleanValue(includeMsgIdsObj, 0, &includeMsgIds) < 0)
+        return NULL;
+    if (queue->payloadType) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "queue payload type must be RAW");
+        return NULL;
+    }
+    numProps = (uint32_t) numPropsFromPython;
+    handles = PyMem_Malloc(numProps * sizeof(dpiMsgProps*));
+    if (!handles)
+        return PyErr_NoMemory();
+
+    // perform dequeue
+    Py_BEGIN_ALLOW_THREADS
+    ok = (dpiQueue_deqMany(queue->handle, &numProps, handles) == DPI_SUCCESS);
+    Py_END_ALLOW_THREADS
+    if (!ok) {
+        PyMem_Free(handles);
+        return cxoError_raiseAndReturnNull();
+    }
+
+    // allocate the offsets buffer and determine the offset of each payload
+    payloads = offsets = msgIds = NULL;
+    offsetsBuffer = PyBytes_FromStringAndSize(NULL,
+            (numProps + 1) * sizeof(Py_ssize_t));
+    ok = (offsetsBuffer) ? 1 : 0;
+    if (ok) {
+        offsetsPtr = (Py_ssize_t*) PyBytes_AS_STRING(offsetsBuffer);
+        offsetsPtr[0] = 0;
+        for (i = 0; i < numProps; i++) {
+            if (dpiMsgProps_getPayload(handles[i], &objHandle, &buffer,
+                    &bufferLength) < 0) {
+                cxoError_raiseAndReturnNull();
+                ok = 0;
+                break;
+            }
+            offsetsPtr[i + 1] = offsetsPtr[i] + bufferLength;
+        }
+    }
+
+    // populate the payload buffer; the payload pointers remain valid until
+    // the message properties handle is released
+    if (ok) {
+        payloads = PyBytes_FromStringAndSize(NULL, offsetsPtr[numProps]);
+        ok = (payloads) ? 1 : 0;
+    }
+    if (ok) {
+        payloadsPtr = PyBytes_AS_STRING(payloads);
+        for (i = 0; i < numProps; i++) {
+            if (dpiMsgProps_getPayload(handles[i], &objHandle, &buffer,
+                    &bufferLength) < 0) {
+                cxoError_raiseAndReturnNull();
+                ok = 0;
+                break;
+            }
+            memcpy(payloadsPtr + offsetsPtr[i], buffer, bufferLength);
+        }
+    }
+
+    // populate the list of message ids, if requested
+    if (ok && includeMsgIds) {
+        msgIds = PyList_New(numProps);
+        ok = (msgIds) ? 1 : 0;
+        for (i = 0; ok && i < numProps; i++) {
+            if (dpiMsgProps_getOriginalMsgId(handles[i], &msgId,
+                    &msgIdLength) < 0) {
+                cxoError_raiseAndReturnNull();
+                ok = 0;
+                break;
+            }
+            PyList_SET_ITEM(msgIds, i,
+                    PyBytes_FromStringAndSize(msgId, msgIdLength));
+            if (!PyList_GET_ITEM(msgIds, i))
+                ok = 0;
+        }
+    }
+
+    // the message properties handles are no longer needed
+    for (i = 0; i < numProps; i++)
+        dpiMsgProps_release(handles[i]);
+    PyMem_Free(handles);
+
+    // expose the offsets as a sequence of integers
+    if (ok) {
+        offsetsView = PyMemoryView_FromObject(offsetsBuffer);
+        if (offsetsView) {
+            offsets = PyObject_CallMethod(offsetsView, "cast", "s", "n");
+            Py_DECREF(offsetsView);
+        }
+        ok = (offsets) ? 1 : 0;
+    }
+    Py_XDECREF(offsetsBuffer);
+    if (!ok) {
+        Py_XDECREF(payloads);
+        Py_XDECREF(offsets);
+        Py_XDECREF(msgIds);
+        return NULL;
+    }
+
+    if (!msgIds) {
+        Py_INCREF(Py_None);
+        msgIds = Py_None;
+    }
+    return Py_BuildValue("(NNN)", payloads, offsets, msgIds);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoQueue_deqOne()
 //   Dequeue a single message to the queue.
@@ -385,6 +882,38 @@ static PyObject *cxoQueue_enqMany(cxoQueue *queue, PyObject *args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoQueue_enqManyRaw()
+//   Enqueue multiple RAW payloads to the queue without the need to create
+// message property objects for each of them.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueue_enqManyRaw(cxoQueue *queue, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "payloads", "offsets", NULL };
+    PyObject *payloads, *offsets;
+
+    // parse arguments
+    offsets = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|O", keywordList,
+            &payloads, &offsets))
+        return NULL;
+    if (offsets == Py_None)
+        offsets = NULL;
+    if (queue->payloadType) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "queue payload type must be RAW");
+        return NULL;
+    }
+
+    // perform enqueue
+    if (cxoQueue_enqRawHelper(queue, payloads, offsets) < 0)
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoQueue_enqOne()
 //   Enqueue a single message to the queue.
@@ -0,0 +1,738 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoSerialize.c
+//   Routines for writing fetched rows into a compact binary format directly
+// from the ODPI-C data buffers and for reading that format back into rows.
+//
+// The format consists of a header followed by the rows. All integers are
+// stored in little-endian byte order.
+//
+//   header: "CXOS", version (uint8), encoding and nencoding (each a uint8
+//           length followed by the characters and a terminating NUL), the
+//           number of columns (uint32) and, for each column, the type code
+//           (uint8) identifying the transform and the name (uint32 length
+//           followed by the name encoded in the encoding), followed by the
+//           number of rows (uint32)
+//   rows:   each value consists of a flag (uint8, 0 for null) followed, if
+//           not null, by the value in the form required by the transform
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+// format identification
+#define CXO_SERIALIZE_MAGIC                 "CXOS"
+#define CXO_SERIALIZE_MAGIC_LENGTH          4
+#define CXO_SERIALIZE_VERSION               2
+
+// initial size of the buffer used for writing
+#define CXO_SERIALIZE_INITIAL_SIZE          8192
+
+// type codes stored in the header for each column; these are part of the
+// format and must not be changed when transforms are added or renumbered
+#define CXO_SERIALIZE_TYPE_BINARY               1
+#define CXO_SERIALIZE_TYPE_BOOLEAN              2
+#define CXO_SERIALIZE_TYPE_DATE                 3
+#define CXO_SERIALIZE_TYPE_DATETIME             4
+#define CXO_SERIALIZE_TYPE_DECIMAL              5
+#define CXO_SERIALIZE_TYPE_EPOCH_MS             6
+#define CXO_SERIALIZE_TYPE_EPOCH_NS             7
+#define CXO_SERIALIZE_TYPE_EPOCH_S              8
+#define CXO_SERIALIZE_TYPE_EPOCH_US             9
+#define CXO_SERIALIZE_TYPE_FIXED_CHAR           10
+#define CXO_SERIALIZE_TYPE_FIXED_NCHAR          11
+#define CXO_SERIALIZE_TYPE_FLOAT                12
+#define CXO_SERIALIZE_TYPE_INT                  13
+#define CXO_SERIALIZE_TYPE_LONG_BINARY          14
+#define CXO_SERIALIZE_TYPE_LONG_STRING          15
+#define CXO_SERIALIZE_TYPE_NATIVE_DOUBLE        16
+#define CXO_SERIALIZE_TYPE_NATIVE_FLOAT         17
+#define CXO_SERIALIZE_TYPE_NATIVE_INT           18
+#define CXO_SERIALIZE_TYPE_NSTRING              19
+#define CXO_SERIALIZE_TYPE_STRING               20
+#define CXO_SERIALIZE_TYPE_TIMEDELTA            21
+#define CXO_SERIALIZE_TYPE_TIMESTAMP            22
+#define CXO_SERIALIZE_TYPE_TIMESTAMP_LTZ        23
+#define CXO_SERIALIZE_TYPE_TIMESTAMP_TZ         24
+#define CXO_SERIALIZE_TYPE_TIMESTAMP_TZ_AWARE   25
+
+// mapping between the type codes and the transforms
+typedef struct {
+    uint8_t typeCode;
+    cxoTransformNum transformNum;
+} cxoSerializeType;
+
+static const cxoSerializeType cxoSerializeTypes[] = {
+    { CXO_SERIALIZE_TYPE_BINARY, CXO_TRANSFORM_BINARY },
+    { CXO_SERIALIZE_TYPE_BOOLEAN, CXO_TRANSFORM_BOOLEAN },
+    { CXO_SERIALIZE_TYPE_DATE, CXO_TRANSFORM_DATE },
+    { CXO_SERIALIZE_TYPE_DATETIME, CXO_TRANSFORM_DATETIME },
+    { CXO_SERIALIZE_TYPE_DECIMAL, CXO_TRANSFORM_DECIMAL },
+    { CXO_SERIALIZE_TYPE_EPOCH_MS, CXO_TRANSFORM_EPOCH_MS },
+    { CXO_SERIALIZE_TYPE_EPOCH_NS, CXO_TRANSFORM_EPOCH_NS },
+    { CXO_SERIALIZE_TYPE_EPOCH_S, CXO_TRANSFORM_EPOCH_S },
+    { CXO_SERIALIZE_TYPE_EPOCH_US, CXO_TRANSFORM_EPOCH_US },
+    { CXO_SERIALIZE_TYPE_FIXED_CHAR, CXO_TRANSFORM_FIXED_CHAR },
+    { CXO_SERIALIZE_TYPE_FIXED_NCHAR, CXO_TRANSFORM_FIXED_NCHAR },
+    { CXO_SERIALIZE_TYPE_FLOAT, CXO_TRANSFORM_FLOAT },
+    { CXO_SERIALIZE_TYPE_INT, CXO_TRANSFORM_INT },
+    { CXO_SERIALIZE_TYPE_LONG_BINARY, CXO_TRANSFORM_LONG_BINARY },
+    { CXO_SERIALIZE_TYPE_LONG_STRING, CXO_TRANSFORM_LONG_STRING },
+    { CXO_SERIALIZE_TYPE_NATIVE_DOUBLE, CXO_TRANSFORM_NATIVE_DOUBLE },
+    { CXO_SERIALIZE_TYPE_NATIVE_FLOAT, CXO_TRANSFORM_NATIVE_FLOAT },
+    { CXO_SERIALIZE_TYPE_NATIVE_INT, CXO_TRANSFORM_NATIVE_INT },
+    { CXO_SERIALIZE_TYPE_NSTRING, CXO_TRANSFORM_NSTRING },
+    { CXO_SERIALIZE_TYPE_STRING, CXO_TRANSFORM_STRING },
+    { CXO_SERIALIZE_TYPE_TIMEDELTA, CXO_TRANSFORM_TIMEDELTA },
+    { CXO_SERIALIZE_TYPE_TIMESTAMP, CXO_TRANSFORM_TIMESTAMP },
+    { CXO_SERIALIZE_TYPE_TIMESTAMP_LTZ, CXO_TRANSFORM_TIMESTAMP_LTZ },
+    { CXO_SERIALIZE_TYPE_TIMESTAMP_TZ, CXO_TRANSFORM_TIMESTAMP_TZ },
+    { CXO_SERIALIZE_TYPE_TIMESTAMP_TZ_AWARE,
+            CXO_TRANSFORM_TIMESTAMP_TZ_AWARE },
+    { 0, CXO_TRANSFORM_NONE }
+};
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_ensureSpace()
+//   Ensure that the buffer has space for the given number of bytes, growing
+// it if necessary.
+//-----------------------------------------------------------------------------
+static int cxoSerialize_ensureSpace(cxoSerializeBuffer *buf, size_t length)
+{
+    size_t allocated;
+    char *ptr;
+
+    if (buf->length + length <= buf->allocated)
+        return 0;
+    allocated = (buf->allocated) ? buf->allocated : CXO_SERIALIZE_INITIAL_SIZE;
+    while (allocated < buf->length + length)
+        allocated *= 2;
+    ptr = PyMem_Realloc(buf->ptr, allocated);
+    if (!ptr) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    buf->ptr = ptr;
+    buf->allocated = allocated;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_writeUInt()
+//   Write an unsigned integer of the given size (in bytes) to the buffer.
+//-----------------------------------------------------------------------------
+static int cxoSerialize_writeUInt(cxoSerializeBuffer *buf, uint64_t value,
+        size_t size)
+{
+    size_t i;
+
+    if (cxoSerialize_ensureSpace(buf, size) < 0)
+        return -1;
+    for (i = 0; i < size; i++)
+        buf->ptr[buf->length++] = (char) ((value >> (i * 8)) & 0xff);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_writeBytes()
+//   Write a length-prefixed sequence of bytes to the buffer.
+//-----------------------------------------------------------------------------
+static int cxoSerialize_writeBytes(cxoSerializeBuffer *buf, const char *ptr,
+        uint32_t length)
+{
+    if (cxoSerialize_writeUInt(buf, length, 4) < 0)
+        return -1;
+    if (cxoSerialize_ensureSpace(buf, length) < 0)
+        return -1;
+    memcpy(buf->ptr + buf->length, ptr, length);
+    buf->length += length;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_writeEncoding()
+//   Write the name of an encoding to the buffer. The terminating NUL is
+// included so that the name can be used in place when the data is read.
+//-----------------------------------------------------------------------------
+static int cxoSerialize_writeEncoding(cxoSerializeBuffer *buf,
+        const char *encoding)
+{
+    size_t length;
+
+    length = (encoding) ? strlen(encoding) : 0;
+    if (length > 254)
+        length = 0;
+    if (cxoSerialize_writeUInt(buf, length, 1) < 0)
+        return -1;
+    if (cxoSerialize_ensureSpace(buf, length + 1) < 0)
+        return -1;
+    if (length > 0)
+        memcpy(buf->ptr + buf->length, encoding, length);
+    buf->ptr[buf->length + length] = '\0';
+    buf->length += length + 1;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_getTypeCode()
+//   Return the type code identifying the transform with which the values of
+// the variable are written. Values which require the connection to be
+// converted (or which have an output converter) cannot be serialized and an
+// exception is raised.
+//-----------------------------------------------------------------------------
+static int cxoSerialize_getTypeCode(cxoVar *var, uint32_t pos,
+        uint8_t *typeCode)
+{
+    cxoTransformNum transformNum;
+    char message[120];
+    int i;
+
+    transformNum = var->transformNum;
+    if (var->outConverter && var->outConverter != Py_None) {
+        snprintf(message, sizeof(message),
+                "column %u has an output converter and cannot be serialized",
+                pos);
+        cxoError_raiseFromString(cxoNotSupportedErrorException, message);
+        return -1;
+    }
+    switch (var->transformNum) {
+        case CXO_TRANSFORM_BFILE:
+        case CXO_TRANSFORM_BLOB:
+        case CXO_TRANSFORM_CLOB:
+        case CXO_TRANSFORM_NCLOB:
+        case CXO_TRANSFORM_CURSOR:
+        case CXO_TRANSFORM_OBJECT:
+            snprintf(message, sizeof(message),
+                    "column %u is of type %s and cannot be serialized", pos,
+                    var->dbType->name);
+            cxoError_raiseFromString(cxoNotSupportedErrorException, message);
+            return -1;
+        case CXO_TRANSFORM_ROWID:
+            transformNum = CXO_TRANSFORM_STRING;
+            break;
+        case CXO_TRANSFORM_SCALED_INT:
+            transformNum = CXO_TRANSFORM_NATIVE_INT;
+            break;
+        default:
+            break;
+    }
+    for (i = 0; cxoSerializeTypes[i].typeCode; i++) {
+        if (cxoSerializeTypes[i].transformNum == transformNum) {
+            *typeCode = cxoSerializeTypes[i].typeCode;
+            return 0;
+        }
+    }
+    snprintf(message, sizeof(message),
+            "column %u is of type %s and cannot be serialized", pos,
+            var->dbType->name);
+    cxoError_raiseFromString(cxoNotSupportedErrorException, message);
+    return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_getTransformNumFromTypeCode()
+//   Return the transform identified by the type code read from the header. An
+// exception is raised if the type code is not known.
+//-----------------------------------------------------------------------------
+static int cxoSerialize_getTransformNumFromTypeCode(uint64_t typeCode,
+        cxoTransformNum *transformNum)
+{
+    int i;
+
+    for (i = 0; cxoSerializeTypes[i].typeCode; i++) {
+        if (cxoSerializeTypes[i].typeCode == typeCode) {
+            *transformNum = cxoSerializeTypes[i].transformNum;
+            return 0;
+        }
+    }
+    cxoError_raiseFromString(cxoProgrammingErrorException,
+            "serialized data is invalid");
+    return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_writeHeader()
+//   Initialize the buffer and write the header for the rows fetched by the
+// cursor. The number of rows is written as zero and is updated when the
+// buffer is finished.
+//-----------------------------------------------------------------------------
+int cxoSerialize_writeHeader(cxoSerializeBuffer *buf, cxoCursor *cursor)
+{
+    dpiQueryInfo queryInfo;
+    uint32_t i, numColumns;
+    uint8_t typeCode;
+    cxoVar *var;
+
+    buf->ptr = NULL;
+    buf->length = buf->allocated = buf->numRowsOffset = 0;
+    if (cxoSerialize_ensureSpace(buf, CXO_SERIALIZE_INITIAL_SIZE) < 0)
+        return -1;
+    memcpy(buf->ptr, CXO_SERIALIZE_MAGIC, CXO_SERIALIZE_MAGIC_LENGTH);
+    buf->length = CXO_SERIALIZE_MAGIC_LENGTH;
+    numColumns = (uint32_t) PyList_GET_SIZE(cursor->fetchVariables);
+    if (cxoSerialize_writeUInt(buf, CXO_SERIALIZE_VERSION, 1) < 0 ||
+            cxoSerialize_writeEncoding(buf,
+                    cursor->connection->encodingInfo.encoding) < 0 ||
+            cxoSerialize_writeEncoding(buf,
+                    cursor->connection->encodingInfo.nencoding) < 0 ||
+            cxoSerialize_writeUInt(buf, numColumns, 4) < 0)
+        return -1;
+    for (i = 0; i < numColumns; i++) {
+        var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i);
+        if (cxoSerialize_getTypeCode(var, i + 1, &typeCode) < 0)
+            return -1;
+        if (dpiStmt_getQueryInfo(cursor->handle, i + 1, &queryInfo) < 0)
+            return cxoError_raiseAndReturnInt();
+        if (cxoSerialize_writeUInt(buf, typeCode, 1) < 0 ||
+                cxoSerialize_writeBytes(buf, queryInfo.name,
+                        queryInfo.nameLength) < 0)
+            return -1;
+    }
+    buf->numRowsOffset = buf->length;
+    return cxoSerialize_writeUInt(buf, 0, 4);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_writeValue()
+//   Write a single value taken directly from the ODPI-C data buffer.
+//-----------------------------------------------------------------------------
+static int cxoSerialize_writeValue(cxoSerializeBuffer *buf, cxoVar *var,
+        dpiData *data)
+{
+    dpiIntervalDS *intervalDS;
+    dpiTimestamp *timestamp;
+    uint32_t rowidLength;
+    int64_t scaledValue;
+    const char *rowid;
+    uint64_t value;
+
+    if (cxoSerialize_writeUInt(buf, !data->isNull, 1) < 0)
+        return -1;
+    if (data->isNull)
+        return 0;
+    switch (var->transformNum) {
+        case CXO_TRANSFORM_BOOLEAN:
+            return cxoSerialize_writeUInt(buf, data->value.asBoolean != 0, 1);
+        case CXO_TRANSFORM_DATE:
+        case CXO_TRANSFORM_DATETIME:
+        case CXO_TRANSFORM_EPOCH_MS:
+        case CXO_TRANSFORM_EPOCH_NS:
+        case CXO_TRANSFORM_EPOCH_S:
+        case CXO_TRANSFORM_EPOCH_US:
+        case CXO_TRANSFORM_TIMESTAMP:
+        case CXO_TRANSFORM_TIMESTAMP_LTZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ_AWARE:
+            timestamp = &data->value.asTimestamp;
+            if (cxoSerialize_writeUInt(buf, (uint16_t) timestamp->year,
+                            2) < 0 ||
+                    cxoSerialize_writeUInt(buf, timestamp->month, 1) < 0 ||
+                    cxoSerialize_writeUInt(buf, timestamp->day, 1) < 0 ||
+                    cxoSerialize_writeUInt(buf, timestamp->hour, 1) < 0 ||
+                    cxoSerialize_writeUInt(buf, timestamp->minute, 1) < 0 ||
+                    cxoSerialize_writeUInt(buf, timestamp->second, 1) < 0 ||
+                    cxoSerialize_writeUInt(buf, timestamp->fsecond, 4) < 0 ||
+                    cxoSerialize_writeUInt(buf,
+                            (uint8_t) timestamp->tzHourOffset, 1) < 0 ||
+                    cxoSerialize_writeUInt(buf,
+                            (uint8_t) timestamp->tzMinuteOffset, 1) < 0)
+                return -1;
+            return 0;
+        case CXO_TRANSFORM_NATIVE_DOUBLE:
+            memcpy(&value, &data->value.asDouble, sizeof(value));
+            return cxoSerialize_writeUInt(buf, value, 8);
+        case CXO_TRANSFORM_NATIVE_FLOAT:
+            value = 0;
+            memcpy(&value, &data->value.asFloat, sizeof(float));
+            return cxoSerialize_writeUInt(buf, value, 4);
+        case CXO_TRANSFORM_NATIVE_INT:
+            return cxoSerialize_writeUInt(buf,
+                    (uint64_t) data->value.asInt64, 8);
+        case CXO_TRANSFORM_SCALED_INT:
+            if (cxoTransform_getScaledInt(&data->value.asBytes, var->scale,
+                    &scaledValue) < 0)
+                return -1;
+            return cxoSerialize_writeUInt(buf, (uint64_t) scaledValue, 8);
+        case CXO_TRANSFORM_ROWID:
+            if (dpiRowid_getStringValue(data->value.asRowid, &rowid,
+                    &rowidLength) < 0)
+                return cxoError_raiseAndReturnInt();
+            return cxoSerialize_writeBytes(buf, rowid, rowidLength);
+        case CXO_TRANSFORM_TIMEDELTA:
+            intervalDS = &data->value.asIntervalDS;
+            if (cxoSerialize_writeUInt(buf, (uint32_t) intervalDS->days,
+                            4) < 0 ||
+                    cxoSerialize_writeUInt(buf, (uint32_t) intervalDS->hours,
+                            4) < 0 ||
+                    cxoSerialize_writeUInt(buf,
+                            (uint32_t) intervalDS->minutes, 4) < 0 ||
+                    cxoSerialize_writeUInt(buf,
+                            (uint32_t) intervalDS->seconds, 4) < 0 ||
+                    cxoSerialize_writeUInt(buf,
+                            (uint32_t) intervalDS->fseconds, 4) < 0)
+                return -1;
+            return 0;
+        default:
+            break;
+    }
+
+    // all remaining transforms (strings, raw data and numbers retrieved as
+    // text) are written as a length-prefixed sequence of bytes
+    return cxoSerialize_writeBytes(buf, data->value.asBytes.ptr,
+            data->value.asBytes.length);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_writeRow()
+//   Write the row found at the given position in the fetch buffers of the
+// cursor.
+//-----------------------------------------------------------------------------
+int cxoSerialize_writeRow(cxoSerializeBuffer *buf, cxoCursor *cursor,
+        uint32_t pos)
+{
+    Py_ssize_t i;
+    cxoVar *var;
+
+    for (i = 0; i < PyList_GET_SIZE(cursor->fetchVariables); i++) {
+        var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i);
+        if (cxoSerialize_writeValue(buf, var, &var->data[pos]) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_finish()
+//   Record the number of rows written in the header and return the contents
+// of the buffer as a bytes object. The buffer is freed in all cases.
+//-----------------------------------------------------------------------------
+PyObject *cxoSerialize_finish(cxoSerializeBuffer *buf, uint32_t numRows)
+{
+    PyObject *result;
+    size_t length;
+
+    length = buf->length;
+    buf->length = buf->numRowsOffset;
+    cxoSerialize_writeUInt(buf, numRows, 4);
+    result = PyBytes_FromStringAndSize(buf->ptr, (Py_ssize_t) length);
+    cxoSerialize_free(buf);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_free()
+//   Free the memory associated with the buffer.
+//-----------------------------------------------------------------------------
+void cxoSerialize_free(cxoSerializeBuffer *buf)
+{
+    if (buf->ptr) {
+        PyMem_Free(buf->ptr);
+        buf->ptr = NULL;
+    }
+    buf->length = buf->allocated = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_read()
+//   Return a pointer to the next set of bytes of the given length in the
+// data being read. An exception is raised if the data is truncated.
+//-----------------------------------------------------------------------------
+static const char *cxoSerialize_read(Py_buffer *view, Py_ssize_t *pos,
+        size_t length)
+{
+    const char *ptr;
+
+    if (length > (size_t) (view->len - *pos)) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "serialized data is truncated");
+        return NULL;
+    }
+    ptr = (const char*) view->buf + *pos;
+    *pos += (Py_ssize_t) length;
+    return ptr;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_readUInt()
+//   Read an unsigned integer of the given size (in bytes).
+//-----------------------------------------------------------------------------
+static int cxoSerialize_readUInt(Py_buffer *view, Py_ssize_t *pos,
+        size_t size, uint64_t *value)
+{
+    const unsigned char *ptr;
+    size_t i;
+
+    ptr = (const unsigned char*) cxoSerialize_read(view, pos, size);
+    if (!ptr)
+        return -1;
+    *value = 0;
+    for (i = 0; i < size; i++)
+        *value |= ((uint64_t) ptr[i]) << (i * 8);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_readBytes()
+//   Read a length-prefixed sequence of bytes.
+//-----------------------------------------------------------------------------
+static int cxoSerialize_readBytes(Py_buffer *view, Py_ssize_t *pos,
+        dpiBytes *bytes)
+{
+    uint64_t length;
+
+    if (cxoSerialize_readUInt(view, pos, 4, &length) < 0)
+        return -1;
+    bytes->length = (uint32_t) length;
+    bytes->ptr = (char*) cxoSerialize_read(view, pos, bytes->length);
+    return (bytes->ptr) ? 0 : -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_readEncoding()
+//   Read the name of an encoding, which is used in place.
+//-----------------------------------------------------------------------------
+static int cxoSerialize_readEncoding(Py_buffer *view, Py_ssize_t *pos,
+        const char **encoding)
+{
+    uint64_t length;
+
+    if (cxoSerialize_readUInt(view, pos, 1, &length) < 0)
+        return -1;
+    *encoding = cxoSerialize_read(view, pos, (size_t) length + 1);
+    if (!*encoding)
+        return -1;
+    if ((*encoding)[length] != '\0') {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "serialized data is invalid");
+        return -1;
+    }
+    if (length == 0)
+        *encoding = NULL;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_readValue()
+//   Read a single value and convert it to Python using the same transform
+// that would have been used when the row was originally fetched.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSerialize_readValue(Py_buffer *view, Py_ssize_t *pos,
+        cxoTransformNum transformNum, const char *encoding,
+        const char *nencoding)
+{
+    dpiIntervalDS *intervalDS;
+    dpiTimestamp *timestamp;
+    uint64_t value, parts[9];
+    dpiDataBuffer dbValue;
+    uint32_t temp;
+    int i;
+
+    if (cxoSerialize_readUInt(view, pos, 1, &value) < 0)
+        return NULL;
+    if (!value)
+        Py_RETURN_NONE;
+    switch (transformNum) {
+        case CXO_TRANSFORM_BOOLEAN:
+            if (cxoSerialize_readUInt(view, pos, 1, &value) < 0)
+                return NULL;
+            dbValue.asBoolean = (int) value;
+            break;
+        case CXO_TRANSFORM_DATE:
+        case CXO_TRANSFORM_DATETIME:
+        case CXO_TRANSFORM_EPOCH_MS:
+        case CXO_TRANSFORM_EPOCH_NS:
+        case CXO_TRANSFORM_EPOCH_S:
+        case CXO_TRANSFORM_EPOCH_US:
+        case CXO_TRANSFORM_TIMESTAMP:
+        case CXO_TRANSFORM_TIMESTAMP_LTZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ_AWARE:
+            for (i = 0; i < 9; i++) {
+                if (cxoSerialize_readUInt(view, pos,
+                        (i == 0) ? 2 : (i == 6) ? 4 : 1, &parts[i]) < 0)
+                    return NULL;
+            }
+            timestamp = &dbValue.asTimestamp;
+            timestamp->year = (int16_t) parts[0];
+            timestamp->month = (uint8_t) parts[1];
+            timestamp->day = (uint8_t) parts[2];
+            timestamp->hour = (uint8_t) parts[3];
+            timestamp->minute = (uint8_t) parts[4];
+            timestamp->second = (uint8_t) parts[5];
+            timestamp->fsecond = (uint32_t) parts[6];
+            timestamp->tzHourOffset = (int8_t) parts[7];
+            timestamp->tzMinuteOffset = (int8_t) parts[8];
+            break;
+        case CXO_TRANSFORM_NATIVE_DOUBLE:
+            if (cxoSerialize_readUInt(view, pos, 8, &value) < 0)
+                return NULL;
+            memcpy(&dbValue.asDouble, &value, sizeof(double));
+            break;
+        case CXO_TRANSFORM_NATIVE_FLOAT:
+            if (cxoSerialize_readUInt(view, pos, 4, &value) < 0)
+                return NULL;
+            temp = (uint32_t) value;
+            memcpy(&dbValue.asFloat, &temp, sizeof(float));
+            break;
+        case CXO_TRANSFORM_NATIVE_INT:
+            if (cxoSerialize_readUInt(view, pos, 8, &value) < 0)
+                return NULL;
+            dbValue.asInt64 = (int64_t) value;
+            break;
+        case CXO_TRANSFORM_TIMEDELTA:
+            for (i = 0; i < 5; i++) {
+                if (cxoSerialize_readUInt(view, pos, 4, &parts[i]) < 0)
+                    return NULL;
+            }
+            intervalDS = &dbValue.asIntervalDS;
+            intervalDS->days = (int32_t) parts[0];
+            intervalDS->hours = (int32_t) parts[1];
+            intervalDS->minutes = (int32_t) parts[2];
+            intervalDS->seconds = (int32_t) parts[3];
+            intervalDS->fseconds = (int32_t) parts[4];
+            break;
+        case CXO_TRANSFORM_BINARY:
+        case CXO_TRANSFORM_DECIMAL:
+        case CXO_TRANSFORM_FIXED_CHAR:
+        case CXO_TRANSFORM_FIXED_NCHAR:
+        case CXO_TRANSFORM_FLOAT:
+        case CXO_TRANSFORM_INT:
+        case CXO_TRANSFORM_LONG_BINARY:
+        case CXO_TRANSFORM_LONG_STRING:
+        case CXO_TRANSFORM_NSTRING:
+        case CXO_TRANSFORM_STRING:
+            if (cxoSerialize_readBytes(view, pos, &dbValue.asBytes) < 0)
+                return NULL;
+            dbValue.asBytes.encoding = (transformNum == CXO_TRANSFORM_NSTRING
+                    || transformNum == CXO_TRANSFORM_FIXED_NCHAR) ?
+                    nencoding : encoding;
+            break;
+        default:
+            return cxoError_raiseFromString(cxoProgrammingErrorException,
+                    "serialized data is invalid");
+    }
+
+    return cxoTransform_toPython(transformNum, NULL, NULL, &dbValue, NULL);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_readRows()
+//   Read the header and rows from the buffer and return a list of tuples.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSerialize_readRows(Py_buffer *view)
+{
+    uint64_t value, numColumns, numRows, rowNum, colNum;
+    const char *magic, *encoding, *nencoding;
+    cxoTransformNum *transformNums;
+    PyObject *rows, *row, *item;
+    Py_ssize_t pos = 0;
+    dpiBytes name;
+
+    // verify the header
+    magic = cxoSerialize_read(view, &pos, CXO_SERIALIZE_MAGIC_LENGTH);
+    if (!magic)
+        return NULL;
+    if (memcmp(magic, CXO_SERIALIZE_MAGIC, CXO_SERIALIZE_MAGIC_LENGTH) != 0)
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "data was not created by Cursor.fetch_serialized()");
+    if (cxoSerialize_readUInt(view, &pos, 1, &value) < 0)
+        return NULL;
+    if (value != CXO_SERIALIZE_VERSION)
+        return cxoError_raiseFromString(cxoNotSupportedErrorException,
+                "serialized data version is not supported");
+    if (cxoSerialize_readEncoding(view, &pos, &encoding) < 0 ||
+            cxoSerialize_readEncoding(view, &pos, &nencoding) < 0 ||
+            cxoSerialize_readUInt(view, &pos, 4, &numColumns) < 0)
+        return NULL;
+    if (numColumns > (uint64_t) (view->len - pos))
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "serialized data is invalid");
+
+    // read the type codes identifying the transforms used for each column;
+    // the names are skipped
+    transformNums = PyMem_Malloc((size_t) (numColumns + 1) *
+            sizeof(cxoTransformNum));
+    if (!transformNums)
+        return PyErr_NoMemory();
+    for (colNum = 0; colNum < numColumns; colNum++) {
+        if (cxoSerialize_readUInt(view, &pos, 1, &value) < 0 ||
+                cxoSerialize_getTransformNumFromTypeCode(value,
+                        &transformNums[colNum]) < 0 ||
+                cxoSerialize_readBytes(view, &pos, &name) < 0) {
+            PyMem_Free(transformNums);
+            return NULL;
+        }
+    }
+    if (cxoSerialize_readUInt(view, &pos, 4, &numRows) < 0) {
+        PyMem_Free(transformNums);
+        return NULL;
+    }
+
+    // read the rows
+    rows = PyList_New(0);
+    if (!rows) {
+        PyMem_Free(transformNums);
+        return NULL;
+    }
+    for (rowNum = 0; rowNum < numRows; rowNum++) {
+        row = PyTuple_New((Py_ssize_t) numColumns);
+        if (!row)
+            break;
+        for (colNum = 0; colNum < numColumns; colNum++) {
+            item = cxoSerialize_readValue(view, &pos, transformNums[colNum],
+                    encoding, nencoding);
+            if (!item)
+                break;
+            PyTuple_SET_ITEM(row, (Py_ssize_t) colNum, item);
+        }
+        if (colNum < numColumns || PyList_Append(rows, row) < 0) {
+            Py_DECREF(row);
+            break;
+        }
+        Py_DECREF(row);
+    }
+    PyMem_Free(transformNums);
+    if (rowNum < numRows) {
+        Py_DECREF(rows);
+        return NULL;
+    }
+
+    return rows;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSerialize_load()
+//   Return the rows found in an object supporting the buffer protocol which
+// contains data created by Cursor.fetch_serialized().
+//-----------------------------------------------------------------------------
+PyObject *cxoSerialize_load(PyObject *obj)
+{
+    PyObject *rows;
+    Py_buffer view;
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_SIMPLE) < 0)
+        return NULL;
+    rows = cxoSerialize_readRows(&view);
+    PyBuffer_Release(&view);
+    return rows;
+}
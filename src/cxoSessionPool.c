@@ -14,6 +14,100 @@
 
 #include "cxoModule.h"
 
+// number of threads used by warm() if none was specified
+#define CXO_POOL_DEFAULT_WARMUP_THREADS         4
+
+// interval (in microseconds) at which threads waiting for the threads started
+// by the pool check for signals
+#define CXO_POOL_SIGNAL_CHECK_INTERVAL          100000
+
+// events posted by the worker threads used by parallel_fetch()
+#define CXO_POOL_FETCH_EVENT_EXECUTED           1
+#define CXO_POOL_FETCH_EVENT_BATCH              2
+#define CXO_POOL_FETCH_EVENT_DONE               3
+
+typedef struct cxoPoolFetch cxoPoolFetch;
+typedef struct cxoPoolFetchWorker cxoPoolFetchWorker;
+typedef struct cxoPoolThreadError cxoPoolThreadError;
+typedef struct cxoPoolWarmup cxoPoolWarmup;
+
+//-----------------------------------------------------------------------------
+// error raised by ODPI-C on a thread started by the pool; the error
+// information is thread specific so it is copied so that the thread which
+// started the work can raise it
+//-----------------------------------------------------------------------------
+struct cxoPoolThreadError {
+    dpiErrorInfo errorInfo;
+    char message[1024];
+    char encoding[64];
+    char sqlState[6];
+};
+
+//-----------------------------------------------------------------------------
+// state shared between parallel_fetch() and its worker threads; each worker
+// has at most one event outstanding so the queue of workers with pending
+// events never holds more than one entry per worker
+//-----------------------------------------------------------------------------
+struct cxoPoolFetch {
+    PyThread_type_lock mutex;
+    PyThread_type_lock signalLock;
+    cxoPoolFetchWorker *workers;
+    cxoPoolFetchWorker **pending;
+    uint32_t numWorkers;
+    uint32_t pendingStart;
+    uint32_t numPending;
+    int signalPending;
+    int cancelled;
+};
+
+//-----------------------------------------------------------------------------
+// state of a worker thread used by parallel_fetch(); the worker executes the
+// query and fetches rows into the buffers of the cursor's fetch variables
+// without holding the GIL, then waits for the calling thread to consume them;
+// the connection is acquired before any worker is started and is used for
+// each of the executions performed by the worker
+//-----------------------------------------------------------------------------
+struct cxoPoolFetchWorker {
+    cxoPoolFetch *fetch;
+    PyObject *connection;
+    cxoCursor *cursor;
+    PyThread_type_lock resumeLock;
+    uint32_t numQueryColumns;
+    uint32_t bufferRowIndex;
+    uint32_t numRows;
+    int event;
+    int status;
+    cxoPoolThreadError error;
+};
+
+//-----------------------------------------------------------------------------
+// state shared by the threads which open sessions in the pool concurrently;
+// each thread acquires connections until the pool contains the requested
+// number of open sessions; the connections must be held until then (since an
+// idle session would otherwise be returned by the next acquire instead of a
+// new session being opened) but all of them are returned to the pool as soon
+// as the requested number of sessions is open; the state is freed once the
+// threads have finished and it is no longer referenced by the pool (which
+// keeps the state of a warmup performed in the background so that an error
+// can be reported by the next call to warm()) or by a thread waiting for the
+// threads to finish
+//-----------------------------------------------------------------------------
+struct cxoPoolWarmup {
+    dpiPool *handle;
+    dpiConn **connections;
+    PyThread_type_lock mutex;
+    PyThread_type_lock doneLock;
+    uint32_t numSessions;
+    uint32_t numOpenRequested;
+    uint32_t nextSession;
+    uint32_t numActiveThreads;
+    uint32_t refCount;
+    int finished;
+    int done;
+    int hasError;
+    cxoPoolThreadError error;
+};
+
 //-----------------------------------------------------------------------------
 // functions for the Python type "SessionPool"
 //-----------------------------------------------------------------------------
@@ -23,7 +117,10 @@ static void cxoSessionPool_free(cxoSessionPool*);
 static PyObject *cxoSessionPool_acquire(cxoSessionPool*, PyObject*, PyObject*);
 static PyObject *cxoSessionPool_close(cxoSessionPool*, PyObject*, PyObject*);
 static PyObject *cxoSessionPool_drop(cxoSessionPool*, PyObject*);
+static PyObject *cxoSessionPool_parallelFetch(cxoSessionPool*, PyObject*,
+        PyObject*);
 static PyObject *cxoSessionPool_release(cxoSessionPool*, PyObject*, PyObject*);
+static PyObject *cxoSessionPool_warm(cxoSessionPool*, PyObject*, PyObject*);
 static PyObject *cxoSessionPool_getBusyCount(cxoSessionPool*, void*);
 static PyObject *cxoSessionPool_getGetMode(cxoSessionPool*, void*);
 static PyObject *cxoSessionPool_getMaxLifetimeSession(cxoSessionPool*, void*);
@@ -37,6 +134,9 @@ static int cxoSessionPool_setMaxLifetimeSession(cxoSessionPool*, PyObject*,
 static int cxoSessionPool_setStmtCacheSize(cxoSessionPool*, PyObject*, void*);
 static int cxoSessionPool_setTimeout(cxoSessionPool*, PyObject*, void*);
 static int cxoSessionPool_setWaitTimeout(cxoSessionPool*, PyObject*, void*);
+static void cxoSessionPool_releaseWarmup(cxoPoolWarmup*);
+static int cxoSessionPool_startWarmup(cxoSessionPool*, uint32_t, uint32_t,
+        uint32_t, int);
 
 
 //-----------------------------------------------------------------------------
@@ -48,8 +148,12 @@ static PyMethodDef cxoSessionPoolMethods[] = {
     { "close", (PyCFunction) cxoSessionPool_close,
             METH_VARARGS | METH_KEYWORDS },
     { "drop", (PyCFunction) cxoSessionPool_drop, METH_VARARGS },
+    { "parallel_fetch", (PyCFunction) cxoSessionPool_parallelFetch,
+            METH_VARARGS | METH_KEYWORDS },
     { "release", (PyCFunction) cxoSessionPool_release,
             METH_VARARGS | METH_KEYWORDS },
+    { "warm", (PyCFunction) cxoSessionPool_warm,
+            METH_VARARGS | METH_KEYWORDS },
     { NULL }
 };
 
@@ -143,7 +247,7 @@ static int cxoSessionPool_init(cxoSessionPool *pool, PyObject *args,
             "increment", "connectiontype", "threaded", "getmode", "events",
             "homogeneous", "externalauth", "encoding", "nencoding", "edition",
             "timeout", "waitTimeout", "maxLifetimeSession", "sessionCallback",
-            "maxSessionsPerShard", NULL };
+            "maxSessionsPerShard", "warmupThreads", NULL };
 
     // parse arguments and keywords
     usernameObj = passwordObj = dsnObj = editionObj = Py_None;
@@ -154,6 +258,7 @@ static int cxoSessionPool_init(cxoSessionPool *pool, PyObject *args,
     maxSessions = 2;
     sessionIncrement = 1;
     maxSessionsPerShard = 0;
+    pool->warmupThreads = 0;
     if (cxoUtils_initializeDPI() < 0)
         return -1;
     if (dpiContext_initCommonCreateParams(cxoDpiContext, &dpiCommonParams) < 0)
@@ -164,14 +269,14 @@ static int cxoSessionPool_init(cxoSessionPool *pool, PyObject *args,
     if (dpiContext_initPoolCreateParams(cxoDpiContext, &dpiCreateParams) < 0)
         return cxoError_raiseAndReturnInt();
     if (!PyArg_ParseTupleAndKeywords(args, keywordArgs,
-            "|OOOiiiOObOOOssOiiiOi", keywordList, &usernameObj, &passwordObj,
+            "|OOOiiiOObOOOssOiiiOiI", keywordList, &usernameObj, &passwordObj,
             &dsnObj, &minSessions, &maxSessions, &sessionIncrement,
             &connectionType, &threadedObj, &dpiCreateParams.getMode,
             &eventsObj, &homogeneousObj, &externalAuthObj,
             &dpiCommonParams.encoding, &dpiCommonParams.nencoding, &editionObj,
             &dpiCreateParams.timeout, &dpiCreateParams.waitTimeout,
             &dpiCreateParams.maxLifetimeSession, &sessionCallbackObj,
-            &maxSessionsPerShard))
+            &maxSessionsPerShard, &pool->warmupThreads))
         return -1;
     if (!PyType_Check(connectionType)) {
         cxoError_raiseFromString(cxoProgrammingErrorException,
@@ -183,9 +288,9 @@ static int cxoSessionPool_init(cxoSessionPool *pool, PyObject *args,
                 "connectiontype must be a subclass of Connection");
         return -1;
     }
-    if (cxoUtils_getBooleanValue(threadedObj, 0, &temp) < 0)
+    if (cxoUtils_getBooleanValue(threadedObj, 0, &pool->threaded) < 0)
         return -1;
-    if (temp)
+    if (pool->threaded)
         dpiCommonParams.createMode |= DPI_MODE_CREATE_THREADED;
     if (cxoUtils_getBooleanValue(eventsObj, 0, &temp) < 0)
         return -1;
@@ -234,7 +339,20 @@ static int cxoSessionPool_init(cxoSessionPool *pool, PyObject *args,
         cxoBuffer_clear(&sessionCallbackBuffer);
         return -1;
     }
+    if (pool->warmupThreads > 0 &&
+            (!pool->threaded || !dpiCreateParams.homogeneous)) {
+        cxoBuffer_clear(&userNameBuffer);
+        cxoBuffer_clear(&passwordBuffer);
+        cxoBuffer_clear(&dsnBuffer);
+        cxoBuffer_clear(&editionBuffer);
+        cxoBuffer_clear(&sessionCallbackBuffer);
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "warmupThreads requires a threaded, homogeneous pool");
+        return -1;
+    }
     dpiCreateParams.minSessions = minSessions;
+    if (pool->warmupThreads > 0 && minSessions > 1)
+        dpiCreateParams.minSessions = 1;
     dpiCreateParams.maxSessions = maxSessions;
     dpiCreateParams.sessionIncrement = sessionIncrement;
     dpiCreateParams.plsqlFixupCallback = sessionCallbackBuffer.ptr;
@@ -270,6 +388,20 @@ static int cxoSessionPool_init(cxoSessionPool *pool, PyObject *args,
     if (!pool->name)
         return -1;
 
+    // when the pool was created with fewer sessions than requested, open the
+    // remaining sessions concurrently and then raise the minimum
+    if (dpiCreateParams.minSessions < minSessions) {
+        if (cxoSessionPool_startWarmup(pool, minSessions, minSessions,
+                pool->warmupThreads, 1) < 0)
+            return -1;
+        Py_BEGIN_ALLOW_THREADS
+        status = dpiPool_reconfigure(pool->handle, minSessions, maxSessions,
+                sessionIncrement);
+        Py_END_ALLOW_THREADS
+        if (status < 0)
+            return cxoError_raiseAndReturnInt();
+    }
+
     return 0;
 }
 
@@ -280,6 +412,10 @@ static int cxoSessionPool_init(cxoSessionPool *pool, PyObject *args,
 //-----------------------------------------------------------------------------
 static void cxoSessionPool_free(cxoSessionPool *pool)
 {
+    if (pool->warmup) {
+        cxoSessionPool_releaseWarmup(pool->warmup);
+        pool->warmup = NULL;
+    }
     if (pool->handle) {
         dpiPool_release(pool->handle);
         pool->handle = NULL;
@@ -381,6 +517,9 @@ static PyObject *cxoSessionPool_drop(cxoSessionPool *pool, PyObject *args)
     // connection is expected
     if (!PyArg_ParseTuple(args, "O!", &cxoPyTypeConnection, &connection))
         return NULL;
+    if (cxoConnection_failGroupCommit(connection,
+            "connection dropped before group commit was performed") < 0)
+        return NULL;
 
     // release the connection
     Py_BEGIN_ALLOW_THREADS
@@ -419,6 +558,9 @@ static PyObject *cxoSessionPool_release(cxoSessionPool *pool, PyObject *args,
         return NULL;
     if (!tagObj)
         tagObj = conn->tag;
+    if (cxoConnection_failGroupCommit(conn,
+            "connection released before group commit was performed") < 0)
+        return NULL;
     if (cxoBuffer_fromObject(&tagBuffer, tagObj,
             pool->encodingInfo.encoding) < 0)
         return NULL;
@@ -441,6 +583,776 @@ static PyObject *cxoSessionPool_release(cxoSessionPool *pool, PyObject *args,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoSessionPool_captureThreadError()
+//   Called by a thread started by the pool when an ODPI-C call fails. The
+// error information is copied so that it remains valid after the thread has
+// finished.
+//-----------------------------------------------------------------------------
+static void cxoSessionPool_captureThreadError(cxoPoolThreadError *error)
+{
+    dpiErrorInfo *errorInfo = &error->errorInfo;
+
+    dpiContext_getError(cxoDpiContext, errorInfo);
+    if (errorInfo->messageLength >= sizeof(error->message))
+        errorInfo->messageLength = sizeof(error->message) - 1;
+    memcpy(error->message, errorInfo->message, errorInfo->messageLength);
+    errorInfo->message = error->message;
+    strncpy(error->encoding, errorInfo->encoding,
+            sizeof(error->encoding) - 1);
+    errorInfo->encoding = error->encoding;
+    strncpy(error->sqlState, errorInfo->sqlState,
+            sizeof(error->sqlState) - 1);
+    errorInfo->sqlState = error->sqlState;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_postFetchEvent()
+//   Called by a worker thread (without the GIL) to place itself on the queue
+// of workers with pending events and wake up the calling thread.
+//-----------------------------------------------------------------------------
+static void cxoSessionPool_postFetchEvent(cxoPoolFetchWorker *worker,
+        int event)
+{
+    cxoPoolFetch *fetch = worker->fetch;
+    uint32_t pos;
+
+    PyThread_acquire_lock(fetch->mutex, WAIT_LOCK);
+    worker->event = event;
+    pos = (fetch->pendingStart + fetch->numPending) % fetch->numWorkers;
+    fetch->pending[pos] = worker;
+    fetch->numPending++;
+    if (!fetch->signalPending) {
+        fetch->signalPending = 1;
+        PyThread_release_lock(fetch->signalLock);
+    }
+    PyThread_release_lock(fetch->mutex);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_waitForFetchResume()
+//   Called by a worker thread (without the GIL) after posting an event in
+// order to wait for the calling thread to process it. Returns 0 if the worker
+// should continue or -1 if the fetch has been cancelled.
+//-----------------------------------------------------------------------------
+static int cxoSessionPool_waitForFetchResume(cxoPoolFetchWorker *worker)
+{
+    int cancelled;
+
+    PyThread_acquire_lock(worker->resumeLock, WAIT_LOCK);
+    PyThread_acquire_lock(worker->fetch->mutex, WAIT_LOCK);
+    cancelled = worker->fetch->cancelled;
+    PyThread_release_lock(worker->fetch->mutex);
+    return (cancelled) ? -1 : 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_parallelFetchWorker()
+//   Entry point of the worker threads used by parallel_fetch(). The query is
+// executed and each batch of rows is fetched without the GIL; the calling
+// thread performs the defines and converts each batch to Python objects.
+//-----------------------------------------------------------------------------
+static void cxoSessionPool_parallelFetchWorker(void *arg)
+{
+    cxoPoolFetchWorker *worker = (cxoPoolFetchWorker*) arg;
+    dpiStmt *handle = worker->cursor->handle;
+    int moreRows;
+
+    if (dpiStmt_execute(handle, DPI_MODE_EXEC_DEFAULT,
+            &worker->numQueryColumns) < 0) {
+        cxoSessionPool_captureThreadError(&worker->error);
+        worker->status = -1;
+    } else {
+        cxoSessionPool_postFetchEvent(worker,
+                CXO_POOL_FETCH_EVENT_EXECUTED);
+        moreRows = (cxoSessionPool_waitForFetchResume(worker) == 0);
+        while (moreRows) {
+            if (dpiStmt_fetchRows(handle, worker->cursor->fetchArraySize,
+                    &worker->bufferRowIndex, &worker->numRows,
+                    &moreRows) < 0) {
+                cxoSessionPool_captureThreadError(&worker->error);
+                worker->status = -1;
+                break;
+            }
+            if (worker->numRows > 0) {
+                cxoSessionPool_postFetchEvent(worker,
+                        CXO_POOL_FETCH_EVENT_BATCH);
+                if (cxoSessionPool_waitForFetchResume(worker) < 0)
+                    break;
+            }
+        }
+    }
+    cxoSessionPool_postFetchEvent(worker, CXO_POOL_FETCH_EVENT_DONE);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_startFetchWorker()
+//   Create a cursor for the connection held by the worker, prepare the
+// statement and bind the given parameters to it, then start a worker thread
+// to execute it.
+//-----------------------------------------------------------------------------
+static int cxoSessionPool_startFetchWorker(cxoSessionPool *pool,
+        cxoPoolFetchWorker *worker, cxoBuffer *statementBuffer,
+        PyObject *parameters, uint32_t arraySize)
+{
+    dpiStmtInfo stmtInfo;
+    cxoCursor *cursor;
+    int status;
+
+    // create a cursor for the connection held by the worker
+    cursor = (cxoCursor*) PyObject_CallMethod(worker->connection, "cursor",
+            NULL);
+    if (!cursor)
+        return -1;
+    worker->cursor = cursor;
+    worker->status = 0;
+
+    // prepare the statement, which must be a query
+    Py_BEGIN_ALLOW_THREADS
+    status = dpiConn_prepareStmt(cursor->connection->handle, 0,
+            (const char*) statementBuffer->ptr, statementBuffer->size, NULL, 0,
+            &cursor->handle);
+    Py_END_ALLOW_THREADS
+    if (status < 0)
+        return cxoError_raiseAndReturnInt();
+    if (dpiStmt_getInfo(cursor->handle, &stmtInfo) < 0)
+        return cxoError_raiseAndReturnInt();
+    if (!stmtInfo.isQuery) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "only queries can be fetched in parallel");
+        return -1;
+    }
+    cursor->arraySize = arraySize;
+    if (dpiStmt_setFetchArraySize(cursor->handle, arraySize) < 0)
+        return cxoError_raiseAndReturnInt();
+
+    // perform binds
+    if (parameters != Py_None && cxoCursor_setBindVariables(cursor,
+            parameters, 1, 0, 0) < 0)
+        return -1;
+    if (cxoCursor_performBind(cursor) < 0)
+        return -1;
+
+    // start the worker thread
+    if (PyThread_start_new_thread(cxoSessionPool_parallelFetchWorker,
+            worker) == (unsigned long) -1) {
+        cxoError_raiseFromString(cxoInterfaceErrorException,
+                "unable to start worker thread");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_waitForFetchEvent()
+//   Wait for a worker thread to post an event and return it. Signals are
+// checked periodically while waiting (unless the fetch has already been
+// cancelled) and NULL is returned if an exception is raised by a signal
+// handler.
+//-----------------------------------------------------------------------------
+static cxoPoolFetchWorker *cxoSessionPool_waitForFetchEvent(
+        cxoPoolFetch *fetch)
+{
+    cxoPoolFetchWorker *worker = NULL;
+    PyLockStatus lockStatus;
+
+    while (1) {
+        Py_BEGIN_ALLOW_THREADS
+        PyThread_acquire_lock(fetch->mutex, WAIT_LOCK);
+        if (fetch->numPending > 0) {
+            worker = fetch->pending[fetch->pendingStart];
+            fetch->pendingStart = (fetch->pendingStart + 1) %
+                    fetch->numWorkers;
+            fetch->numPending--;
+        }
+        PyThread_release_lock(fetch->mutex);
+        lockStatus = PY_LOCK_ACQUIRED;
+        if (!worker) {
+            lockStatus = PyThread_acquire_lock_timed(fetch->signalLock,
+                    CXO_POOL_SIGNAL_CHECK_INTERVAL, 0);
+            if (lockStatus == PY_LOCK_ACQUIRED) {
+                PyThread_acquire_lock(fetch->mutex, WAIT_LOCK);
+                fetch->signalPending = 0;
+                PyThread_release_lock(fetch->mutex);
+            }
+        }
+        Py_END_ALLOW_THREADS
+        if (worker)
+            break;
+        if (lockStatus != PY_LOCK_ACQUIRED && !fetch->cancelled &&
+                PyErr_CheckSignals() < 0)
+            return NULL;
+    }
+
+    return worker;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_cancelFetch()
+//   Called when an error occurs during a parallel fetch. The first exception
+// raised is saved so that it can be raised once all of the worker threads
+// have finished and the workers are told to stop.
+//-----------------------------------------------------------------------------
+static void cxoSessionPool_cancelFetch(cxoPoolFetch *fetch,
+        PyObject **excType, PyObject **excValue, PyObject **excTraceback)
+{
+    if (*excType)
+        return;
+    PyErr_Fetch(excType, excValue, excTraceback);
+    PyThread_acquire_lock(fetch->mutex, WAIT_LOCK);
+    fetch->cancelled = 1;
+    PyThread_release_lock(fetch->mutex);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_deliverFetchBatch()
+//   Convert the batch of rows fetched by a worker into a list of columns,
+// each of which is a list of values, and pass it to the consumer.
+//-----------------------------------------------------------------------------
+static int cxoSessionPool_deliverFetchBatch(cxoPoolFetchWorker *worker,
+        PyObject *consumer)
+{
+    PyObject *columns, *column, *value, *result;
+    Py_ssize_t numColumns, i;
+    uint32_t row;
+    cxoVar *var;
+
+    numColumns = PyList_GET_SIZE(worker->cursor->fetchVariables);
+    columns = PyList_New(numColumns);
+    if (!columns)
+        return -1;
+    for (i = 0; i < numColumns; i++) {
+        column = PyList_New(worker->numRows);
+        if (!column) {
+            Py_DECREF(columns);
+            return -1;
+        }
+        PyList_SET_ITEM(columns, i, column);
+        var = (cxoVar*) PyList_GET_ITEM(worker->cursor->fetchVariables, i);
+        for (row = 0; row < worker->numRows; row++) {
+            value = cxoVar_getValue(var, worker->bufferRowIndex + row);
+            if (!value) {
+                Py_DECREF(columns);
+                return -1;
+            }
+            PyList_SET_ITEM(column, row, value);
+        }
+    }
+    result = PyObject_CallFunctionObjArgs(consumer, columns, NULL);
+    Py_DECREF(columns);
+    if (!result)
+        return -1;
+    Py_DECREF(result);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_parallelFetch()
+//   Execute a query once for each of the given sets of bind values, each on
+// connection acquired from the pool. The executes and fetches are performed
+// by worker threads without the GIL while the calling thread converts each
+// batch of rows and passes it to the consumer. The connections used by the
+// workers are all acquired before any worker is started and are retained
+// until all executions have completed; acquiring a connection while workers
+// are waiting for the calling thread could otherwise deadlock if the pool
+// has no more sessions available. For the same reason, the number of workers
+// is limited to the number of sessions that are not in use (but is at least
+// one). The total number of rows fetched is returned.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSessionPool_parallelFetch(cxoSessionPool *pool,
+        PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "statement", "bindSets", "consumer",
+            "threads", "arraysize", NULL };
+    PyObject *statement, *bindSetsObj, *bindSets, *consumer;
+    PyObject *excType, *excValue, *excTraceback;
+    Py_ssize_t numBindSets, nextBindSet;
+    uint32_t numThreads, arraySize, numBusy, i;
+    cxoPoolFetchWorker *worker;
+    cxoBuffer statementBuffer;
+    uint32_t numActive;
+    uint64_t numRows;
+    cxoPoolFetch fetch;
+    int status;
+
+    // parse arguments
+    numThreads = 0;
+    arraySize = 100;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "OOO|II",
+            keywordList, &statement, &bindSetsObj, &consumer, &numThreads,
+            &arraySize))
+        return NULL;
+    if (!PyCallable_Check(consumer)) {
+        PyErr_SetString(PyExc_TypeError, "consumer must be callable");
+        return NULL;
+    }
+    if (arraySize == 0) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "arraysize must be greater than zero");
+        return NULL;
+    }
+    if (!pool->threaded) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "pool must be created with threaded=True");
+        return NULL;
+    }
+    bindSets = PySequence_Fast(bindSetsObj, "expecting a sequence");
+    if (!bindSets)
+        return NULL;
+    numBindSets = PySequence_Fast_GET_SIZE(bindSets);
+    if (numBindSets == 0) {
+        Py_DECREF(bindSets);
+        return PyLong_FromLong(0);
+    }
+    if (dpiPool_getBusyCount(pool->handle, &numBusy) < 0) {
+        Py_DECREF(bindSets);
+        return cxoError_raiseAndReturnNull();
+    }
+    if (numThreads == 0 || numThreads > pool->maxSessions)
+        numThreads = pool->maxSessions;
+    if (numBusy >= pool->maxSessions)
+        numThreads = 1;
+    else if (numThreads > pool->maxSessions - numBusy)
+        numThreads = pool->maxSessions - numBusy;
+    if ((Py_ssize_t) numThreads > numBindSets)
+        numThreads = (uint32_t) numBindSets;
+    if (cxoBuffer_fromObject(&statementBuffer, statement,
+            pool->encodingInfo.encoding) < 0) {
+        Py_DECREF(bindSets);
+        return NULL;
+    }
+
+    // initialize state shared with the worker threads
+    memset(&fetch, 0, sizeof(fetch));
+    fetch.numWorkers = numThreads;
+    fetch.workers = PyMem_Calloc(numThreads, sizeof(cxoPoolFetchWorker));
+    fetch.pending = PyMem_Calloc(numThreads, sizeof(cxoPoolFetchWorker*));
+    fetch.mutex = PyThread_allocate_lock();
+    fetch.signalLock = PyThread_allocate_lock();
+    status = (fetch.workers && fetch.pending && fetch.mutex &&
+            fetch.signalLock) ? 0 : -1;
+    for (i = 0; status == 0 && i < numThreads; i++) {
+        fetch.workers[i].fetch = &fetch;
+        fetch.workers[i].resumeLock = PyThread_allocate_lock();
+        if (!fetch.workers[i].resumeLock)
+            status = -1;
+        else PyThread_acquire_lock(fetch.workers[i].resumeLock, NOWAIT_LOCK);
+    }
+    if (status < 0)
+        PyErr_NoMemory();
+    else PyThread_acquire_lock(fetch.signalLock, NOWAIT_LOCK);
+
+    // acquire the connections used by the workers
+    for (i = 0; status == 0 && i < numThreads; i++) {
+        fetch.workers[i].connection = PyObject_CallMethod((PyObject*) pool,
+                "acquire", NULL);
+        if (!fetch.workers[i].connection)
+            status = -1;
+    }
+
+    // start workers as threads become available and process the events they
+    // post; once an error occurs no further workers are started and the
+    // active ones are told to stop, but they must all finish before the
+    // shared state can be freed
+    excType = excValue = excTraceback = NULL;
+    nextBindSet = 0;
+    numActive = 0;
+    numRows = 0;
+    while (status == 0 || numActive > 0) {
+        for (i = 0; status == 0 && i < numThreads &&
+                nextBindSet < numBindSets; i++) {
+            worker = &fetch.workers[i];
+            if (worker->cursor)
+                continue;
+            status = cxoSessionPool_startFetchWorker(pool, worker,
+                    &statementBuffer,
+                    PySequence_Fast_GET_ITEM(bindSets, nextBindSet++),
+                    arraySize);
+            if (status == 0)
+                numActive++;
+            else Py_CLEAR(worker->cursor);
+        }
+        if (status < 0)
+            cxoSessionPool_cancelFetch(&fetch, &excType, &excValue,
+                    &excTraceback);
+        if (numActive == 0)
+            break;
+        worker = cxoSessionPool_waitForFetchEvent(&fetch);
+        if (!worker) {
+            status = -1;
+            cxoSessionPool_cancelFetch(&fetch, &excType, &excValue,
+                    &excTraceback);
+            continue;
+        }
+        if (worker->event == CXO_POOL_FETCH_EVENT_DONE) {
+            Py_CLEAR(worker->cursor);
+            numActive--;
+            if (status == 0 && worker->status < 0)
+                status = cxoError_raiseFromInfo(&worker->error.errorInfo);
+        } else if (status == 0 &&
+                worker->event == CXO_POOL_FETCH_EVENT_EXECUTED) {
+            status = cxoCursor_performDefine(worker->cursor,
+                    worker->numQueryColumns);
+        } else if (status == 0) {
+            numRows += worker->numRows;
+            status = cxoSessionPool_deliverFetchBatch(worker, consumer);
+        }
+        if (status < 0)
+            cxoSessionPool_cancelFetch(&fetch, &excType, &excValue,
+                    &excTraceback);
+        if (worker->event != CXO_POOL_FETCH_EVENT_DONE)
+            PyThread_release_lock(worker->resumeLock);
+    }
+
+    // release the connections and free the shared state
+    for (i = 0; fetch.workers && i < numThreads; i++) {
+        Py_CLEAR(fetch.workers[i].connection);
+        if (fetch.workers[i].resumeLock)
+            PyThread_free_lock(fetch.workers[i].resumeLock);
+    }
+    if (fetch.mutex)
+        PyThread_free_lock(fetch.mutex);
+    if (fetch.signalLock)
+        PyThread_free_lock(fetch.signalLock);
+    PyMem_Free(fetch.workers);
+    PyMem_Free(fetch.pending);
+    cxoBuffer_clear(&statementBuffer);
+    Py_DECREF(bindSets);
+
+    if (status < 0) {
+        if (excType)
+            PyErr_Restore(excType, excValue, excTraceback);
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(numRows);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_freeWarmup()
+//   Free the state used to open sessions concurrently. This may be called
+// without the GIL.
+//-----------------------------------------------------------------------------
+static void cxoSessionPool_freeWarmup(cxoPoolWarmup *warmup)
+{
+    if (warmup->handle)
+        dpiPool_release(warmup->handle);
+    if (warmup->mutex)
+        PyThread_free_lock(warmup->mutex);
+    if (warmup->doneLock)
+        PyThread_free_lock(warmup->doneLock);
+    PyMem_RawFree(warmup->connections);
+    PyMem_RawFree(warmup);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_releaseWarmup()
+//   Release a reference to the state used to open sessions concurrently and
+// free it when the last reference is released. This may be called without the
+// GIL.
+//-----------------------------------------------------------------------------
+static void cxoSessionPool_releaseWarmup(cxoPoolWarmup *warmup)
+{
+    int isLast;
+
+    PyThread_acquire_lock(warmup->mutex, WAIT_LOCK);
+    isLast = (--warmup->refCount == 0);
+    PyThread_release_lock(warmup->mutex);
+    if (isLast)
+        cxoSessionPool_freeWarmup(warmup);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_releaseWarmupConnections()
+//   Return the connections held for opening sessions concurrently to the
+// pool. The mutex must be held when this is called.
+//-----------------------------------------------------------------------------
+static void cxoSessionPool_releaseWarmupConnections(cxoPoolWarmup *warmup)
+{
+    uint32_t i;
+
+    for (i = 0; i < warmup->numSessions; i++) {
+        if (warmup->connections[i]) {
+            dpiConn_release(warmup->connections[i]);
+            warmup->connections[i] = NULL;
+        }
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_finishWarmupThread()
+//   Called when a thread participating in opening sessions concurrently has
+// finished. The last thread to finish returns any connections that are still
+// held to the pool and wakes up any thread waiting for the threads to finish.
+//-----------------------------------------------------------------------------
+static void cxoSessionPool_finishWarmupThread(cxoPoolWarmup *warmup)
+{
+    int isLast;
+
+    PyThread_acquire_lock(warmup->mutex, WAIT_LOCK);
+    isLast = (--warmup->numActiveThreads == 0);
+    if (isLast) {
+        cxoSessionPool_releaseWarmupConnections(warmup);
+        warmup->done = 1;
+        PyThread_release_lock(warmup->doneLock);
+    }
+    PyThread_release_lock(warmup->mutex);
+    if (isLast)
+        cxoSessionPool_releaseWarmup(warmup);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_warmupThread()
+//   Entry point of the threads which open sessions concurrently. Each thread
+// acquires connections from the pool until the pool contains the requested
+// number of open sessions or an error occurs. As soon as that number has been
+// reached, all of the connections are returned to the pool; connections that
+// are acquired afterwards by other threads are returned immediately. The
+// first error that occurs is retained so that it can be reported.
+//-----------------------------------------------------------------------------
+static void cxoSessionPool_warmupThread(void *arg)
+{
+    cxoPoolWarmup *warmup = (cxoPoolWarmup*) arg;
+    uint32_t pos, numOpen;
+    dpiConn *conn;
+    int status;
+
+    while (1) {
+        PyThread_acquire_lock(warmup->mutex, WAIT_LOCK);
+        pos = warmup->nextSession;
+        if (!warmup->finished && pos < warmup->numSessions)
+            warmup->nextSession++;
+        else pos = warmup->numSessions;
+        PyThread_release_lock(warmup->mutex);
+        if (pos >= warmup->numSessions)
+            break;
+        status = dpiPool_acquireConnection(warmup->handle, NULL, 0, NULL, 0,
+                NULL, &conn);
+        if (status == 0)
+            status = dpiPool_getOpenCount(warmup->handle, &numOpen);
+        PyThread_acquire_lock(warmup->mutex, WAIT_LOCK);
+        if (status < 0 && !warmup->hasError) {
+            cxoSessionPool_captureThreadError(&warmup->error);
+            warmup->hasError = 1;
+        }
+        if (status == 0 && !warmup->finished)
+            warmup->connections[pos] = conn;
+        else if (status == 0)
+            dpiConn_release(conn);
+        if (status < 0 || numOpen >= warmup->numOpenRequested) {
+            warmup->finished = 1;
+            cxoSessionPool_releaseWarmupConnections(warmup);
+        }
+        PyThread_release_lock(warmup->mutex);
+    }
+    cxoSessionPool_finishWarmupThread(warmup);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_waitForWarmup()
+//   Wait for the threads opening sessions concurrently to finish, checking
+// for signals periodically, and raise the first error that occurred, if any.
+//-----------------------------------------------------------------------------
+static int cxoSessionPool_waitForWarmup(cxoPoolWarmup *warmup)
+{
+    PyLockStatus lockStatus;
+
+    while (1) {
+        Py_BEGIN_ALLOW_THREADS
+        lockStatus = PyThread_acquire_lock_timed(warmup->doneLock,
+                CXO_POOL_SIGNAL_CHECK_INTERVAL, 0);
+        Py_END_ALLOW_THREADS
+        if (lockStatus == PY_LOCK_ACQUIRED)
+            break;
+        if (PyErr_CheckSignals() < 0)
+            return -1;
+    }
+    PyThread_release_lock(warmup->doneLock);
+    if (warmup->hasError)
+        return cxoError_raiseFromInfo(&warmup->error.errorInfo);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_checkWarmup()
+//   Raise the error that occurred while opening sessions in the background
+// for the previous call to warm(), if that has finished. The state is then
+// no longer retained by the pool.
+//-----------------------------------------------------------------------------
+static int cxoSessionPool_checkWarmup(cxoSessionPool *pool)
+{
+    cxoPoolWarmup *warmup = pool->warmup;
+    int done, status = 0;
+
+    if (!warmup)
+        return 0;
+    PyThread_acquire_lock(warmup->mutex, WAIT_LOCK);
+    done = warmup->done;
+    PyThread_release_lock(warmup->mutex);
+    if (!done)
+        return 0;
+    if (warmup->hasError)
+        status = cxoError_raiseFromInfo(&warmup->error.errorInfo);
+    pool->warmup = NULL;
+    cxoSessionPool_releaseWarmup(warmup);
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_startWarmup()
+//   Start the given number of threads which open sessions until the pool
+// contains the requested number of open sessions. At most the given number
+// of connections are acquired for that purpose. If requested, wait for the
+// threads to finish; otherwise, the sessions are opened in the background and
+// the state is retained by the pool so that an error can be reported later.
+//-----------------------------------------------------------------------------
+static int cxoSessionPool_startWarmup(cxoSessionPool *pool,
+        uint32_t numSessions, uint32_t numOpenRequested, uint32_t numThreads,
+        int wait)
+{
+    cxoPoolWarmup *warmup;
+    int status = 0;
+    uint32_t i;
+
+    // allocate and initialize the state shared by the threads
+    warmup = PyMem_RawCalloc(1, sizeof(cxoPoolWarmup));
+    if (!warmup) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    warmup->connections = PyMem_RawCalloc(numSessions, sizeof(dpiConn*));
+    warmup->mutex = PyThread_allocate_lock();
+    warmup->doneLock = PyThread_allocate_lock();
+    if (!warmup->connections || !warmup->mutex || !warmup->doneLock) {
+        cxoSessionPool_freeWarmup(warmup);
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyThread_acquire_lock(warmup->doneLock, NOWAIT_LOCK);
+    if (dpiPool_addRef(pool->handle) < 0) {
+        cxoSessionPool_freeWarmup(warmup);
+        return cxoError_raiseAndReturnInt();
+    }
+    warmup->handle = pool->handle;
+    warmup->numSessions = numSessions;
+    warmup->numOpenRequested = numOpenRequested;
+
+    // the threads hold one reference to the state; the other is held by the
+    // pool or by the calling thread while it waits for the threads to finish
+    warmup->refCount = 2;
+
+    // start the threads; the calling thread is counted as one of the active
+    // threads until all of them have been started so that the state cannot be
+    // freed while threads are still being started
+    if (numThreads > numSessions)
+        numThreads = numSessions;
+    warmup->numActiveThreads = 1;
+    for (i = 0; i < numThreads; i++) {
+        PyThread_acquire_lock(warmup->mutex, WAIT_LOCK);
+        warmup->numActiveThreads++;
+        PyThread_release_lock(warmup->mutex);
+        if (PyThread_start_new_thread(cxoSessionPool_warmupThread,
+                warmup) == (unsigned long) -1) {
+            PyThread_acquire_lock(warmup->mutex, WAIT_LOCK);
+            warmup->numActiveThreads--;
+            PyThread_release_lock(warmup->mutex);
+            cxoError_raiseFromString(cxoInterfaceErrorException,
+                    "unable to start warmup thread");
+            status = -1;
+            break;
+        }
+    }
+    Py_BEGIN_ALLOW_THREADS
+    cxoSessionPool_finishWarmupThread(warmup);
+    Py_END_ALLOW_THREADS
+
+    // wait for the threads to finish, if requested; otherwise, the pool
+    // retains the state in place of the state of any previous warmup
+    if (wait || status < 0) {
+        if (status == 0)
+            status = cxoSessionPool_waitForWarmup(warmup);
+        cxoSessionPool_releaseWarmup(warmup);
+    } else {
+        if (pool->warmup)
+            cxoSessionPool_releaseWarmup(pool->warmup);
+        pool->warmup = warmup;
+    }
+
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_warm()
+//   Open sessions until the pool contains at least the given number of
+// sessions (or its maximum size is reached). By default the sessions are
+// opened in the background and any error that occurs is raised by the next
+// call; if requested, the sessions are opened before returning the number of
+// open sessions and any error is raised immediately.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSessionPool_warm(cxoSessionPool *pool, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "numSessions", "threads", "wait", NULL };
+    uint32_t numSessions, numThreads, numOpen, numBusy;
+    PyObject *waitObj;
+    int wait;
+
+    // parse arguments
+    numThreads = 0;
+    waitObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "I|IO", keywordList,
+            &numSessions, &numThreads, &waitObj))
+        return NULL;
+    if (cxoUtils_getBooleanValue(waitObj, 0, &wait) < 0)
+        return NULL;
+    if (!pool->threaded || !pool->homogeneous)
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "warming requires a threaded, homogeneous pool");
+    if (numThreads == 0)
+        numThreads = (pool->warmupThreads > 0) ? pool->warmupThreads :
+                CXO_POOL_DEFAULT_WARMUP_THREADS;
+
+    // report any error that occurred during the previous warmup
+    if (cxoSessionPool_checkWarmup(pool) < 0)
+        return NULL;
+
+    // determine how many connections need to be acquired; sessions that are
+    // busy cannot be acquired so only the remaining ones are needed
+    if (dpiPool_getOpenCount(pool->handle, &numOpen) < 0 ||
+            dpiPool_getBusyCount(pool->handle, &numBusy) < 0)
+        return cxoError_raiseAndReturnNull();
+    if (numSessions > pool->maxSessions)
+        numSessions = pool->maxSessions;
+
+    // open the sessions
+    if (numSessions > numOpen && cxoSessionPool_startWarmup(pool,
+            numSessions - numBusy, numSessions, numThreads, wait) < 0)
+        return NULL;
+    if (!wait)
+        Py_RETURN_NONE;
+    if (dpiPool_getOpenCount(pool->handle, &numOpen) < 0)
+        return cxoError_raiseAndReturnNull();
+    return PyLong_FromUnsignedLong(numOpen);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoSessionPool_getAttribute()
 //   Return the value for the attribute.
@@ -20,10 +20,14 @@
 static void cxoSubscr_free(cxoSubscr*);
 static PyObject *cxoSubscr_repr(cxoSubscr*);
 static PyObject *cxoSubscr_registerQuery(cxoSubscr*, PyObject*);
+static void cxoSubscr_bufferMessage(cxoSubscr*, dpiSubscrMessage*);
+static dpiSubscrMessage *cxoSubscr_copyMessage(dpiSubscrMessage*);
+static void cxoSubscr_freeMessage(dpiSubscrMessage*);
 static void cxoMessage_free(cxoMessage*);
 static void cxoMessageTable_free(cxoMessageTable*);
 static void cxoMessageRow_free(cxoMessageRow*);
 static void cxoMessageQuery_free(cxoMessageQuery*);
+static PyObject *cxoMessageTable_getRows(cxoMessageTable*, void*);
 
 //-----------------------------------------------------------------------------
 // declaration of members for Python types
@@ -41,6 +45,13 @@ static PyMemberDef cxoSubscrTypeMembers[] = {
     { "operations", T_UINT, offsetof(cxoSubscr, operations), READONLY },
     { "qos", T_UINT, offsetof(cxoSubscr, qos), READONLY },
     { "id", T_ULONG, offsetof(cxoSubscr, id), READONLY },
+    { "bufferSize", T_UINT, offsetof(cxoSubscr, bufferSize), READONLY },
+    { "coalesceWindow", T_UINT, offsetof(cxoSubscr, coalesceWindow),
+            READONLY },
+    { "droppedEvents", T_ULONGLONG, offsetof(cxoSubscr, droppedEvents),
+            READONLY },
+    { "coalescedEvents", T_ULONGLONG, offsetof(cxoSubscr, coalescedEvents),
+            READONLY },
     { NULL }
 };
 
@@ -60,7 +71,6 @@ static PyMemberDef cxoMessageTypeMembers[] = {
 
 static PyMemberDef cxoMessageTableTypeMembers[] = {
     { "name", T_OBJECT, offsetof(cxoMessageTable, name), READONLY },
-    { "rows", T_OBJECT, offsetof(cxoMessageTable, rows), READONLY },
     { "operation", T_INT, offsetof(cxoMessageTable, operation), READONLY },
     { NULL }
 };
@@ -79,6 +89,15 @@ static PyMemberDef cxoMessageQueryTypeMembers[] = {
 };
 
 
+//-----------------------------------------------------------------------------
+// declaration of calculated members for Python types
+//-----------------------------------------------------------------------------
+static PyGetSetDef cxoMessageTableTypeCalcMembers[] = {
+    { "rows", (getter) cxoMessageTable_getRows, 0, 0, 0 },
+    { NULL }
+};
+
+
 //-----------------------------------------------------------------------------
 // declaration of methods for Python types
 //-----------------------------------------------------------------------------
@@ -118,7 +137,8 @@ PyTypeObject cxoPyTypeMessageTable = {
     .tp_basicsize = sizeof(cxoMessageTable),
     .tp_dealloc = (destructor) cxoMessageTable_free,
     .tp_flags = Py_TPFLAGS_DEFAULT,
-    .tp_members = cxoMessageTableTypeMembers
+    .tp_members = cxoMessageTableTypeMembers,
+    .tp_getset = cxoMessageTableTypeCalcMembers
 };
 
 
@@ -162,33 +182,95 @@ static int cxoMessageRow_initialize(cxoMessageRow *rowObj,
 //-----------------------------------------------------------------------------
 // cxoMessageTable_initialize()
 //   Initialize a new message table with the information from the descriptor.
+// The rows are not converted to Python objects at this point; instead, they
+// are copied into a single compact block of memory (the row structures
+// followed by the rowids they point to and the name of the encoding used to
+// decode them) and only converted when the rows attribute is first accessed.
+// The encoding is copied since the connection may have been closed by then.
 //-----------------------------------------------------------------------------
 static int cxoMessageTable_initialize(cxoMessageTable *tableObj,
         const char *encoding, dpiSubscrMessageTable *table)
 {
-    cxoMessageRow *row;
+    size_t rowidsLength, encodingLength;
+    char *rowids;
     uint32_t i;
 
     tableObj->operation = table->operation;
     tableObj->name = PyUnicode_Decode(table->name, table->nameLength, encoding,
             NULL);
-    tableObj->rows = PyList_New(table->numRows);
-    if (!tableObj->rows)
+    if (!tableObj->name)
+        return -1;
+    if (table->numRows == 0)
+        return 0;
+    rowidsLength = 0;
+    for (i = 0; i < table->numRows; i++)
+        rowidsLength += table->rows[i].rowidLength;
+    encodingLength = strlen(encoding) + 1;
+    tableObj->rowData = PyMem_Malloc(table->numRows *
+            sizeof(dpiSubscrMessageRow) + rowidsLength + encodingLength);
+    if (!tableObj->rowData) {
+        PyErr_NoMemory();
         return -1;
+    }
+    tableObj->numRows = table->numRows;
+    rowids = (char*) &tableObj->rowData[table->numRows];
     for (i = 0; i < table->numRows; i++) {
-        row = (cxoMessageRow*)
-                cxoPyTypeMessageRow.tp_alloc(&cxoPyTypeMessageRow, 0);
-        if (!row)
-            return -1;
-        PyList_SET_ITEM(tableObj->rows, i, (PyObject*) row);
-        if (cxoMessageRow_initialize(row, encoding, &table->rows[i]) < 0)
-            return -1;
+        tableObj->rowData[i].operation = table->rows[i].operation;
+        tableObj->rowData[i].rowid = rowids;
+        tableObj->rowData[i].rowidLength = table->rows[i].rowidLength;
+        memcpy(rowids, table->rows[i].rowid, table->rows[i].rowidLength);
+        rowids += table->rows[i].rowidLength;
     }
+    memcpy(rowids, encoding, encodingLength);
+    tableObj->encoding = rowids;
 
     return 0;
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoMessageTable_getRows()
+//   Return the list of rows for the table, creating the row objects from the
+// compact copy made when the table was initialized, if needed. Once created,
+// the list is retained and the compact copy is discarded.
+//-----------------------------------------------------------------------------
+static PyObject *cxoMessageTable_getRows(cxoMessageTable *table, void *unused)
+{
+    cxoMessageRow *row;
+    PyObject *rows;
+    uint32_t i;
+
+    if (!table->rows) {
+        rows = PyList_New(table->numRows);
+        if (!rows)
+            return NULL;
+        for (i = 0; i < table->numRows; i++) {
+            row = (cxoMessageRow*)
+                    cxoPyTypeMessageRow.tp_alloc(&cxoPyTypeMessageRow, 0);
+            if (!row) {
+                Py_DECREF(rows);
+                return NULL;
+            }
+            PyList_SET_ITEM(rows, i, (PyObject*) row);
+            if (cxoMessageRow_initialize(row, table->encoding,
+                    &table->rowData[i]) < 0) {
+                Py_DECREF(rows);
+                return NULL;
+            }
+        }
+        table->rows = rows;
+        if (table->rowData) {
+            PyMem_Free(table->rowData);
+            table->rowData = NULL;
+            table->encoding = NULL;
+        }
+    }
+
+    Py_INCREF(table->rows);
+    return table->rows;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoMessageQuery_initialize()
 //   Initialize a new message query with the information from the descriptor.
@@ -336,12 +418,37 @@ static int cxoSubscr_callbackHandler(cxoSubscr *subscr,
 
 //-----------------------------------------------------------------------------
 // cxoSubscr_callback()
-//   Routine that is called when a callback needs to be invoked.
+//   Routine that is called when a callback needs to be invoked. If the
+// subscription buffers events, the message is copied into the buffer without
+// acquiring the GIL and is delivered later by the delivery thread; otherwise,
+// the callback is invoked immediately. The result cache of the connection is
+// invalidated first, if the subscription is associated with it.
 //-----------------------------------------------------------------------------
 void cxoSubscr_callback(cxoSubscr *subscr, dpiSubscrMessage *message)
 {
 #ifdef WITH_THREAD
-    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyGILState_STATE gstate;
+
+    // invalidate the result cache of the connection, if this subscription is
+    // used for that purpose; this is done immediately, even if the message is
+    // buffered, so that stale results are never returned from the cache
+    if (subscr->connection->resultCacheSubscr == subscr &&
+            !message->errorInfo) {
+        gstate = PyGILState_Ensure();
+        cxoConnection_invalidateResultCache(subscr->connection, subscr,
+                message);
+        PyGILState_Release(gstate);
+    }
+
+    if (subscr->bufferSize > 0 && !message->errorInfo) {
+        cxoSubscr_bufferMessage(subscr, message);
+        return;
+    }
+    gstate = PyGILState_Ensure();
+#else
+    if (!message->errorInfo)
+        cxoConnection_invalidateResultCache(subscr->connection, subscr,
+                message);
 #endif
 
     if (message->errorInfo) {
@@ -356,16 +463,534 @@ void cxoSubscr_callback(cxoSubscr *subscr, dpiSubscrMessage *message)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoSubscr_copyString()
+//   Return a copy of the given string (or bytes) using the raw memory
+// allocator, which is safe to use without holding the GIL. NULL is returned
+// if the string is NULL or if memory cannot be allocated; the caller must
+// distinguish between the two.
+//-----------------------------------------------------------------------------
+static char *cxoSubscr_copyString(const char *value, uint32_t valueLength)
+{
+    char *copy;
+
+    if (!value)
+        return NULL;
+    copy = PyMem_RawMalloc(valueLength + 1);
+    if (copy) {
+        memcpy(copy, value, valueLength);
+        copy[valueLength] = '\0';
+    }
+    return copy;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_freeTable()
+//   Free the contents of a table copied by cxoSubscr_copyTable().
+//-----------------------------------------------------------------------------
+static void cxoSubscr_freeTable(dpiSubscrMessageTable *table)
+{
+    uint32_t i;
+
+    if (table->rows) {
+        for (i = 0; i < table->numRows; i++)
+            PyMem_RawFree((char*) table->rows[i].rowid);
+        PyMem_RawFree(table->rows);
+    }
+    PyMem_RawFree((char*) table->name);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_freeTables()
+//   Free the tables copied by cxoSubscr_copyTables().
+//-----------------------------------------------------------------------------
+static void cxoSubscr_freeTables(dpiSubscrMessageTable *tables,
+        uint32_t numTables)
+{
+    uint32_t i;
+
+    if (!tables)
+        return;
+    for (i = 0; i < numTables; i++)
+        cxoSubscr_freeTable(&tables[i]);
+    PyMem_RawFree(tables);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_copyTable()
+//   Copy a single table (and its rows) into the given location.
+//-----------------------------------------------------------------------------
+static int cxoSubscr_copyTable(dpiSubscrMessageTable *copy,
+        dpiSubscrMessageTable *table)
+{
+    dpiSubscrMessageRow *row;
+    uint32_t i;
+
+    copy->operation = table->operation;
+    copy->nameLength = table->nameLength;
+    copy->name = cxoSubscr_copyString(table->name, table->nameLength);
+    if (!copy->name)
+        return -1;
+    if (table->numRows == 0)
+        return 0;
+    copy->rows = PyMem_RawCalloc(table->numRows, sizeof(dpiSubscrMessageRow));
+    if (!copy->rows)
+        return -1;
+    for (i = 0; i < table->numRows; i++) {
+        row = &copy->rows[i];
+        row->operation = table->rows[i].operation;
+        row->rowidLength = table->rows[i].rowidLength;
+        row->rowid = cxoSubscr_copyString(table->rows[i].rowid,
+                table->rows[i].rowidLength);
+        if (!row->rowid)
+            return -1;
+        copy->numRows++;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_copyTables()
+//   Copy an array of tables. On error, any memory allocated is freed.
+//-----------------------------------------------------------------------------
+static int cxoSubscr_copyTables(dpiSubscrMessageTable *tables,
+        uint32_t numTables, dpiSubscrMessageTable **copy)
+{
+    uint32_t i;
+
+    *copy = NULL;
+    if (numTables == 0)
+        return 0;
+    *copy = PyMem_RawCalloc(numTables, sizeof(dpiSubscrMessageTable));
+    if (!*copy)
+        return -1;
+    for (i = 0; i < numTables; i++) {
+        if (cxoSubscr_copyTable(&(*copy)[i], &tables[i]) < 0) {
+            cxoSubscr_freeTables(*copy, i + 1);
+            *copy = NULL;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_freeMessage()
+//   Free a message copied by cxoSubscr_copyMessage().
+//-----------------------------------------------------------------------------
+static void cxoSubscr_freeMessage(dpiSubscrMessage *message)
+{
+    uint32_t i;
+
+    cxoSubscr_freeTables(message->tables, message->numTables);
+    if (message->queries) {
+        for (i = 0; i < message->numQueries; i++)
+            cxoSubscr_freeTables(message->queries[i].tables,
+                    message->queries[i].numTables);
+        PyMem_RawFree(message->queries);
+    }
+    PyMem_RawFree((char*) message->dbName);
+    PyMem_RawFree((void*) message->txId);
+    PyMem_RawFree((char*) message->queueName);
+    PyMem_RawFree((char*) message->consumerName);
+    PyMem_RawFree(message);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_copyMessage()
+//   Return a deep copy of the message supplied by ODPI-C, which is only valid
+// for the duration of the callback. Error information is not copied since
+// messages containing errors are never buffered. NULL is returned if memory
+// cannot be allocated.
+//-----------------------------------------------------------------------------
+static dpiSubscrMessage *cxoSubscr_copyMessage(dpiSubscrMessage *message)
+{
+    dpiSubscrMessageQuery *query;
+    dpiSubscrMessage *copy;
+    int ok = 1;
+    uint32_t i;
+
+    copy = PyMem_RawCalloc(1, sizeof(dpiSubscrMessage));
+    if (!copy)
+        return NULL;
+    copy->eventType = message->eventType;
+    copy->registered = message->registered;
+    copy->dbNameLength = message->dbNameLength;
+    copy->dbName = cxoSubscr_copyString(message->dbName,
+            message->dbNameLength);
+    if (message->dbName && !copy->dbName)
+        ok = 0;
+    copy->txIdLength = message->txIdLength;
+    copy->txId = cxoSubscr_copyString(message->txId, message->txIdLength);
+    if (message->txId && !copy->txId)
+        ok = 0;
+    copy->queueNameLength = message->queueNameLength;
+    copy->queueName = cxoSubscr_copyString(message->queueName,
+            message->queueNameLength);
+    if (message->queueName && !copy->queueName)
+        ok = 0;
+    copy->consumerNameLength = message->consumerNameLength;
+    copy->consumerName = cxoSubscr_copyString(message->consumerName,
+            message->consumerNameLength);
+    if (message->consumerName && !copy->consumerName)
+        ok = 0;
+    if (ok && cxoSubscr_copyTables(message->tables, message->numTables,
+            &copy->tables) < 0)
+        ok = 0;
+    if (ok)
+        copy->numTables = message->numTables;
+    if (ok && message->numQueries > 0) {
+        copy->queries = PyMem_RawCalloc(message->numQueries,
+                sizeof(dpiSubscrMessageQuery));
+        if (!copy->queries)
+            ok = 0;
+        for (i = 0; ok && i < message->numQueries; i++) {
+            query = &copy->queries[i];
+            query->id = message->queries[i].id;
+            query->operation = message->queries[i].operation;
+            if (cxoSubscr_copyTables(message->queries[i].tables,
+                    message->queries[i].numTables, &query->tables) < 0) {
+                ok = 0;
+                break;
+            }
+            query->numTables = message->queries[i].numTables;
+            copy->numQueries++;
+        }
+    }
+    if (!ok) {
+        cxoSubscr_freeMessage(copy);
+        return NULL;
+    }
+
+    return copy;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_coalesceMessage()
+//   Attempt to merge an object change message into a pending object change
+// message. For each table in the message, the table is either added to the
+// pending message or, if the pending message already contains the table, the
+// operations are combined. A table that has been changed by more than one
+// event no longer retains the individual rows; instead, the operation
+// DPI_OPCODE_ALL_ROWS is added, as is done by the database when too many rows
+// have been changed. Returns -1 if memory could not be allocated.
+//-----------------------------------------------------------------------------
+static int cxoSubscr_coalesceMessage(dpiSubscrMessage *pending,
+        dpiSubscrMessage *message)
+{
+    dpiSubscrMessageTable *table, *pendingTable, *tables;
+    uint32_t i, j;
+
+    for (i = 0; i < message->numTables; i++) {
+        table = &message->tables[i];
+
+        // search for the table in the pending message
+        pendingTable = NULL;
+        for (j = 0; j < pending->numTables; j++) {
+            if (pending->tables[j].nameLength == table->nameLength &&
+                    memcmp(pending->tables[j].name, table->name,
+                            table->nameLength) == 0) {
+                pendingTable = &pending->tables[j];
+                break;
+            }
+        }
+
+        // if found, combine the operations and discard the rows
+        if (pendingTable) {
+            pendingTable->operation |= table->operation;
+            if (pendingTable->rows || table->numRows > 0) {
+                for (j = 0; j < pendingTable->numRows; j++)
+                    PyMem_RawFree((char*) pendingTable->rows[j].rowid);
+                PyMem_RawFree(pendingTable->rows);
+                pendingTable->rows = NULL;
+                pendingTable->numRows = 0;
+                pendingTable->operation |= DPI_OPCODE_ALL_ROWS;
+            }
+            continue;
+        }
+
+        // otherwise, add the table to the pending message; the number of
+        // tables is only incremented once the copy has succeeded so that a
+        // partially copied table is never delivered
+        tables = PyMem_RawRealloc(pending->tables,
+                (pending->numTables + 1) * sizeof(dpiSubscrMessageTable));
+        if (!tables)
+            return -1;
+        pending->tables = tables;
+        memset(&tables[pending->numTables], 0, sizeof(dpiSubscrMessageTable));
+        if (cxoSubscr_copyTable(&tables[pending->numTables], table) < 0) {
+            cxoSubscr_freeTable(&tables[pending->numTables]);
+            return -1;
+        }
+        pending->numTables++;
+
+    }
+
+    // the combined message no longer refers to a single transaction
+    PyMem_RawFree((void*) pending->txId);
+    pending->txId = NULL;
+    pending->txIdLength = 0;
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_bufferMessage()
+//   Add the message to the bounded buffer of pending messages without
+// acquiring the GIL. Object change messages are coalesced with a pending
+// object change message, if one exists; otherwise, a copy of the message is
+// appended to the buffer. If the buffer is full, the message is dropped. The
+// delivery thread is signalled when the buffer transitions from empty to
+// non-empty.
+//-----------------------------------------------------------------------------
+static void cxoSubscr_bufferMessage(cxoSubscr *subscr,
+        dpiSubscrMessage *message)
+{
+    dpiSubscrMessage *pending, *copy;
+    uint32_t i;
+
+    PyThread_acquire_lock(subscr->bufferLock, WAIT_LOCK);
+
+    // once the delivery thread has been asked to stop, messages are discarded
+    if (subscr->stopping) {
+        subscr->droppedEvents++;
+        PyThread_release_lock(subscr->bufferLock);
+        return;
+    }
+
+    // attempt to coalesce with a pending message
+    if (message->eventType == DPI_EVENT_OBJCHANGE) {
+        for (i = subscr->numPendingMessages; i > 0; i--) {
+            pending = subscr->pendingMessages[i - 1];
+            if (pending->eventType != DPI_EVENT_OBJCHANGE)
+                continue;
+            if (cxoSubscr_coalesceMessage(pending, message) < 0)
+                subscr->droppedEvents++;
+            else subscr->coalescedEvents++;
+            PyThread_release_lock(subscr->bufferLock);
+            return;
+        }
+    }
+
+    // otherwise, add a copy to the buffer, if there is space available
+    copy = NULL;
+    if (subscr->numPendingMessages < subscr->bufferSize)
+        copy = cxoSubscr_copyMessage(message);
+    if (!copy) {
+        subscr->droppedEvents++;
+    } else {
+        subscr->pendingMessages[subscr->numPendingMessages++] = copy;
+        if (subscr->numPendingMessages == 1)
+            PyThread_release_lock(subscr->eventLock);
+    }
+
+    PyThread_release_lock(subscr->bufferLock);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_deliveryThread()
+//   Thread which delivers buffered messages to the callback. After being
+// signalled that messages are available, the thread waits for the coalescing
+// window to elapse and then delivers all of the pending messages with the GIL
+// held. The thread does not keep the subscription alive: a reference is only
+// held while messages are being delivered. If that reference turns out to be
+// the last one, the thread stops and releases it, which deallocates the
+// subscription; if the subscription is deallocated by another thread, any
+// remaining messages are discarded and the thread stops.
+//-----------------------------------------------------------------------------
+static void cxoSubscr_deliveryThread(void *arg)
+{
+    cxoSubscr *subscr = (cxoSubscr*) arg;
+    dpiSubscrMessage **messages;
+    PyGILState_STATE gstate;
+    uint32_t numMessages, i;
+    int stopping, orphaned;
+
+    do {
+
+        // wait for messages to become available and allow them to accumulate
+        // for the duration of the coalescing window; the stop lock is only
+        // acquirable once the thread has been asked to stop
+        PyThread_acquire_lock(subscr->eventLock, WAIT_LOCK);
+        if (!subscr->stopping && subscr->coalesceWindow > 0 &&
+                PyThread_acquire_lock_timed(subscr->stopLock,
+                        (PY_TIMEOUT_T) subscr->coalesceWindow * 1000,
+                        0) == PY_LOCK_ACQUIRED)
+            PyThread_release_lock(subscr->stopLock);
+
+        // take ownership of the pending messages
+        PyThread_acquire_lock(subscr->bufferLock, WAIT_LOCK);
+        stopping = subscr->stopping;
+        messages = subscr->pendingMessages;
+        numMessages = subscr->numPendingMessages;
+        subscr->pendingMessages = subscr->deliveryMessages;
+        subscr->deliveryMessages = messages;
+        subscr->numPendingMessages = 0;
+        PyThread_release_lock(subscr->bufferLock);
+
+        // deliver the messages to the callback, unless the subscription is
+        // being deallocated; if the subscription is referenced only by this
+        // thread once the messages have been delivered, it is no longer
+        // reachable and the thread stops
+        orphaned = 0;
+        if (numMessages > 0) {
+            gstate = PyGILState_Ensure();
+            if (!subscr->deallocating) {
+                Py_INCREF(subscr);
+                for (i = 0; i < numMessages; i++) {
+                    if (cxoSubscr_callbackHandler(subscr, messages[i]) < 0)
+                        PyErr_Print();
+                }
+                if (Py_REFCNT(subscr) == 1) {
+                    PyThread_acquire_lock(subscr->bufferLock, WAIT_LOCK);
+                    subscr->stopping = 1;
+                    PyThread_release_lock(subscr->bufferLock);
+                    orphaned = stopping = 1;
+                } else Py_DECREF(subscr);
+            }
+            PyGILState_Release(gstate);
+            for (i = 0; i < numMessages; i++)
+                cxoSubscr_freeMessage(messages[i]);
+        }
+
+    } while (!stopping);
+
+    // signal that the thread has completed; if this thread holds the last
+    // reference to the subscription, release it, which deallocates the
+    // subscription; the subscription must not be accessed afterwards
+    if (orphaned) {
+        gstate = PyGILState_Ensure();
+        PyThread_release_lock(subscr->threadDoneLock);
+        Py_DECREF(subscr);
+        PyGILState_Release(gstate);
+    } else PyThread_release_lock(subscr->threadDoneLock);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_startDelivery()
+//   Allocate the buffers and locks required for buffering messages and start
+// the thread which delivers them to the callback.
+//-----------------------------------------------------------------------------
+int cxoSubscr_startDelivery(cxoSubscr *subscr)
+{
+    subscr->pendingMessages = PyMem_RawCalloc(subscr->bufferSize,
+            sizeof(dpiSubscrMessage*));
+    subscr->deliveryMessages = PyMem_RawCalloc(subscr->bufferSize,
+            sizeof(dpiSubscrMessage*));
+    if (!subscr->pendingMessages || !subscr->deliveryMessages) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    subscr->bufferLock = PyThread_allocate_lock();
+    subscr->eventLock = PyThread_allocate_lock();
+    subscr->stopLock = PyThread_allocate_lock();
+    subscr->threadDoneLock = PyThread_allocate_lock();
+    if (!subscr->bufferLock || !subscr->eventLock || !subscr->stopLock ||
+            !subscr->threadDoneLock) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyThread_acquire_lock(subscr->eventLock, WAIT_LOCK);
+    PyThread_acquire_lock(subscr->stopLock, WAIT_LOCK);
+    PyThread_acquire_lock(subscr->threadDoneLock, WAIT_LOCK);
+    subscr->deliveryThreadId =
+            PyThread_start_new_thread(cxoSubscr_deliveryThread, subscr);
+    if (subscr->deliveryThreadId == (unsigned long) -1) {
+        PyThread_release_lock(subscr->threadDoneLock);
+        subscr->threadDone = 1;
+        cxoError_raiseFromString(cxoInterfaceErrorException,
+                "unable to start notification delivery thread");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_stopDelivery()
+//   Stop the delivery thread (after any pending messages have been delivered)
+// and wait for it to complete. This must be called after the subscription has
+// been deregistered so that no further messages are buffered. If called from
+// the delivery thread itself, the thread is not waited for since it will stop
+// once the callback returns.
+//-----------------------------------------------------------------------------
+void cxoSubscr_stopDelivery(cxoSubscr *subscr)
+{
+    if (!subscr->threadDoneLock || subscr->threadDone)
+        return;
+    if (!subscr->stopping) {
+        PyThread_acquire_lock(subscr->bufferLock, WAIT_LOCK);
+        subscr->stopping = 1;
+        if (subscr->numPendingMessages == 0)
+            PyThread_release_lock(subscr->eventLock);
+        PyThread_release_lock(subscr->bufferLock);
+        PyThread_release_lock(subscr->stopLock);
+    }
+    if (PyThread_get_thread_ident() == subscr->deliveryThreadId)
+        return;
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(subscr->threadDoneLock, WAIT_LOCK);
+    Py_END_ALLOW_THREADS
+    subscr->threadDone = 1;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoSubscr_free()
 //   Free the memory associated with a subscription.
 //-----------------------------------------------------------------------------
 static void cxoSubscr_free(cxoSubscr *subscr)
 {
+    uint32_t i;
+
+    // release the handle (which deregisters the subscription) and then stop
+    // the delivery thread, if one was started; messages that have not yet
+    // been delivered are discarded
     if (subscr->handle) {
         dpiSubscr_release(subscr->handle);
         subscr->handle = NULL;
     }
+    subscr->deallocating = 1;
+    cxoSubscr_stopDelivery(subscr);
+    if (subscr->pendingMessages) {
+        for (i = 0; i < subscr->numPendingMessages; i++)
+            cxoSubscr_freeMessage(subscr->pendingMessages[i]);
+        PyMem_RawFree(subscr->pendingMessages);
+        subscr->pendingMessages = NULL;
+    }
+    if (subscr->deliveryMessages) {
+        PyMem_RawFree(subscr->deliveryMessages);
+        subscr->deliveryMessages = NULL;
+    }
+    if (subscr->bufferLock) {
+        PyThread_free_lock(subscr->bufferLock);
+        subscr->bufferLock = NULL;
+    }
+    if (subscr->eventLock) {
+        PyThread_free_lock(subscr->eventLock);
+        subscr->eventLock = NULL;
+    }
+    if (subscr->stopLock) {
+        PyThread_free_lock(subscr->stopLock);
+        subscr->stopLock = NULL;
+    }
+    if (subscr->threadDoneLock) {
+        PyThread_free_lock(subscr->threadDoneLock);
+        subscr->threadDoneLock = NULL;
+    }
     Py_CLEAR(subscr->connection);
     Py_CLEAR(subscr->callback);
     Py_CLEAR(subscr->name);
@@ -528,6 +1153,10 @@ static void cxoMessageRow_free(cxoMessageRow *row)
 //-----------------------------------------------------------------------------
 static void cxoMessageTable_free(cxoMessageTable *table)
 {
+    if (table->rowData) {
+        PyMem_Free(table->rowData);
+        table->rowData = NULL;
+    }
     Py_CLEAR(table->name);
     Py_CLEAR(table->rows);
     Py_TYPE(table)->tp_free((PyObject*) table);
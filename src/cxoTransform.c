@@ -28,6 +28,11 @@
 static Py_ssize_t cxoTransform_calculateSize(PyObject *value,
         cxoTransformNum transformNum);
 static cxoTransformNum cxoTransform_getNumFromPythonType(PyTypeObject *type);
+static PyObject *cxoTransform_getTimezone(int8_t hourOffset,
+        int8_t minuteOffset);
+static int cxoTransform_setTimezoneOffset(PyObject *value,
+        dpiTimestamp *timestamp);
+static PyObject *cxoTransform_toDecimal(dpiBytes *bytes);
 
 
 //-----------------------------------------------------------------------------
@@ -40,12 +45,22 @@ typedef struct {
 } cxoTransform;
 
 
+//-----------------------------------------------------------------------------
+// Constants
+//-----------------------------------------------------------------------------
+
+// time zone offsets (in minutes) must be strictly between -24 and 24 hours
+#define CXO_TRANSFORM_MAX_TZ_OFFSET         (24 * 60 - 1)
+
+
 //-----------------------------------------------------------------------------
 // Globals
 //-----------------------------------------------------------------------------
 PyTypeObject *cxoPyTypeDate;
 PyTypeObject *cxoPyTypeDateTime;
 static PyTypeObject *cxoPyTypeDecimal;
+static PyObject *cxoPyTypeTimezone;
+static PyObject *cxoTransformTimezones[CXO_TRANSFORM_MAX_TZ_OFFSET * 2 + 1];
 static const cxoTransform cxoAllTransforms[] = {
     {
         CXO_TRANSFORM_NONE,
@@ -97,6 +112,26 @@ static const cxoTransform cxoAllTransforms[] = {
         DPI_ORACLE_TYPE_NUMBER,
         DPI_NATIVE_TYPE_BYTES
     },
+    {
+        CXO_TRANSFORM_EPOCH_MS,
+        DPI_ORACLE_TYPE_TIMESTAMP,
+        DPI_NATIVE_TYPE_TIMESTAMP
+    },
+    {
+        CXO_TRANSFORM_EPOCH_NS,
+        DPI_ORACLE_TYPE_TIMESTAMP,
+        DPI_NATIVE_TYPE_TIMESTAMP
+    },
+    {
+        CXO_TRANSFORM_EPOCH_S,
+        DPI_ORACLE_TYPE_TIMESTAMP,
+        DPI_NATIVE_TYPE_TIMESTAMP
+    },
+    {
+        CXO_TRANSFORM_EPOCH_US,
+        DPI_ORACLE_TYPE_TIMESTAMP,
+        DPI_NATIVE_TYPE_TIMESTAMP
+    },
     {
         CXO_TRANSFORM_FIXED_CHAR,
         DPI_ORACLE_TYPE_CHAR,
@@ -162,6 +197,11 @@ static const cxoTransform cxoAllTransforms[] = {
         DPI_ORACLE_TYPE_ROWID,
         DPI_NATIVE_TYPE_ROWID
     },
+    {
+        CXO_TRANSFORM_SCALED_INT,
+        DPI_ORACLE_TYPE_NUMBER,
+        DPI_NATIVE_TYPE_BYTES
+    },
     {
         CXO_TRANSFORM_STRING,
         DPI_ORACLE_TYPE_VARCHAR,
@@ -186,6 +226,11 @@ static const cxoTransform cxoAllTransforms[] = {
         CXO_TRANSFORM_TIMESTAMP_TZ,
         DPI_ORACLE_TYPE_TIMESTAMP_TZ,
         DPI_NATIVE_TYPE_TIMESTAMP
+    },
+    {
+        CXO_TRANSFORM_TIMESTAMP_TZ_AWARE,
+        DPI_ORACLE_TYPE_TIMESTAMP_TZ,
+        DPI_NATIVE_TYPE_TIMESTAMP
     }
 };
 
@@ -234,9 +279,9 @@ int cxoTransform_fromPython(cxoTransformNum transformNum,
         const char *nencoding, cxoVar *var, uint32_t arrayPos)
 {
     dpiIntervalDS *interval;
+    int64_t epochValue;
     PyDateTime_Delta *delta;
     int32_t deltaSeconds;
-    PyObject *textValue;
     cxoObject *obj;
     cxoLob *lob;
     int status;
@@ -314,12 +359,7 @@ int cxoTransform_fromPython(cxoTransformNum transformNum,
                     PyErr_SetString(PyExc_TypeError, "expecting number");
                     return -1;
                 }
-                textValue = PyObject_Str(pyValue);
-                if (!textValue)
-                    return -1;
-                status = cxoBuffer_fromObject(buffer, textValue, encoding);
-                Py_DECREF(textValue);
-                if (status < 0)
+                if (cxoBuffer_fromNumber(buffer, pyValue, encoding) < 0)
                     return -1;
             }
             dbValue->asBytes.ptr = (char*) buffer->ptr;
@@ -351,11 +391,25 @@ int cxoTransform_fromPython(cxoTransformNum transformNum,
                     return cxoError_raiseAndReturnInt();
             } else dbValue->asObject = obj->handle;
             return 0;
+        case CXO_TRANSFORM_EPOCH_MS:
+        case CXO_TRANSFORM_EPOCH_NS:
+        case CXO_TRANSFORM_EPOCH_S:
+        case CXO_TRANSFORM_EPOCH_US:
+            if (PyLong_Check(pyValue)) {
+                epochValue = PyLong_AsLongLong(pyValue);
+                if (PyErr_Occurred())
+                    return -1;
+                return cxoUtils_setEpochTime(epochValue,
+                        cxoTransform_getEpochUnitsPerSecond(transformNum),
+                        &dbValue->asTimestamp);
+            }
+            // fall through
         case CXO_TRANSFORM_DATE:
         case CXO_TRANSFORM_DATETIME:
         case CXO_TRANSFORM_TIMESTAMP:
         case CXO_TRANSFORM_TIMESTAMP_LTZ:
         case CXO_TRANSFORM_TIMESTAMP_TZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ_AWARE:
             if (PyDateTime_Check(pyValue)) {
                 memset(&dbValue->asTimestamp, 0, sizeof(dbValue->asTimestamp));
                 dbValue->asTimestamp.year = PyDateTime_GET_YEAR(pyValue);
@@ -368,6 +422,10 @@ int cxoTransform_fromPython(cxoTransformNum transformNum,
                         PyDateTime_DATE_GET_SECOND(pyValue);
                 dbValue->asTimestamp.fsecond =
                         PyDateTime_DATE_GET_MICROSECOND(pyValue) * 1000;
+                if (transformNum == CXO_TRANSFORM_TIMESTAMP_TZ_AWARE &&
+                        cxoTransform_setTimezoneOffset(pyValue,
+                                &dbValue->asTimestamp) < 0)
+                    return -1;
             } else if (PyDate_Check(pyValue)) {
                 memset(&dbValue->asTimestamp, 0, sizeof(dbValue->asTimestamp));
                 dbValue->asTimestamp.year = PyDateTime_GET_YEAR(pyValue);
@@ -420,6 +478,7 @@ uint32_t cxoTransform_getDefaultSize(cxoTransformNum transformNum)
         case CXO_TRANSFORM_DECIMAL:
         case CXO_TRANSFORM_FLOAT:
         case CXO_TRANSFORM_INT:
+        case CXO_TRANSFORM_SCALED_INT:
             return 1000;
         case CXO_TRANSFORM_FIXED_CHAR:
         case CXO_TRANSFORM_FIXED_NCHAR:
@@ -435,6 +494,30 @@ uint32_t cxoTransform_getDefaultSize(cxoTransformNum transformNum)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoTransform_getEpochUnitsPerSecond()
+//   Return the number of units per second used by the transforms which
+// return timestamps as the time elapsed since the epoch, or 0 if the
+// transform is not one of them.
+//-----------------------------------------------------------------------------
+int64_t cxoTransform_getEpochUnitsPerSecond(cxoTransformNum transformNum)
+{
+    switch (transformNum) {
+        case CXO_TRANSFORM_EPOCH_S:
+            return 1;
+        case CXO_TRANSFORM_EPOCH_MS:
+            return 1000;
+        case CXO_TRANSFORM_EPOCH_US:
+            return 1000000;
+        case CXO_TRANSFORM_EPOCH_NS:
+            return 1000000000;
+        default:
+            break;
+    }
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoTransform_getNumFromDataTypeInfo()
 //   Get the default transformation to use for the specified data type.
@@ -704,6 +787,96 @@ int cxoTransform_getNumFromValue(PyObject *value, int *isArray,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoTransform_getScaledInt()
+//   Return the number in text form returned by ODPI-C as a 64-bit integer
+// scaled by 10 to the power of the given scale (so that 123.45 with a scale
+// of 2 becomes 12345). An exception is raised if the number has more decimal
+// places than the scale or the scaled value does not fit in 64 bits. The text
+// is parsed directly so encodings that are not ASCII compatible are rejected.
+//-----------------------------------------------------------------------------
+int cxoTransform_getScaledInt(dpiBytes *bytes, int8_t scale, int64_t *value)
+{
+    int isNegative, inFraction = 0, numFractionDigits = 0;
+    const char *ptr, *endPtr;
+    int64_t result = 0;
+    int digit;
+
+    if (!cxoUtils_isAsciiCompatible(bytes->encoding)) {
+        cxoError_raiseFromString(cxoNotSupportedErrorException,
+                "numbers cannot be fetched as scaled integers when the "
+                "connection encoding is UTF-16");
+        return -1;
+    }
+    ptr = bytes->ptr;
+    endPtr = ptr + bytes->length;
+    isNegative = (ptr < endPtr && *ptr == '-');
+    if (isNegative)
+        ptr++;
+    for (; ptr < endPtr; ptr++) {
+        if (*ptr == '.' && !inFraction) {
+            inFraction = 1;
+            continue;
+        }
+        if (*ptr < '0' || *ptr > '9')
+            goto invalid;
+        if (inFraction && ++numFractionDigits > scale)
+            goto invalid;
+        digit = *ptr - '0';
+        if (result > (INT64_MAX - digit) / 10)
+            goto invalid;
+        result = result * 10 + digit;
+    }
+    for (; numFractionDigits < scale; numFractionDigits++) {
+        if (result > INT64_MAX / 10)
+            goto invalid;
+        result *= 10;
+    }
+    *value = (isNegative) ? -result : result;
+    return 0;
+
+invalid:
+    cxoError_raiseFromString(cxoDataErrorException,
+            "number cannot be represented as a scaled 64-bit integer");
+    return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_getTimezone()
+//   Return the time zone object for the given offset. One object is created
+// for each distinct offset and cached, so that building an aware datetime
+// does not require any Python calls once the offset has been seen. A borrowed
+// reference is returned.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_getTimezone(int8_t hourOffset,
+        int8_t minuteOffset)
+{
+    PyObject *delta, *timezone;
+    int offset;
+
+    offset = hourOffset * 60 + minuteOffset;
+    if (offset < -CXO_TRANSFORM_MAX_TZ_OFFSET ||
+            offset > CXO_TRANSFORM_MAX_TZ_OFFSET)
+        return cxoError_raiseFromString(cxoDataErrorException,
+                "time zone offset is out of range");
+    timezone = cxoTransformTimezones[offset + CXO_TRANSFORM_MAX_TZ_OFFSET];
+    if (!timezone) {
+        delta = PyDelta_FromDSU(0, offset * 60, 0);
+        if (!delta)
+            return NULL;
+        timezone = PyObject_CallFunctionObjArgs(cxoPyTypeTimezone, delta,
+                NULL);
+        Py_DECREF(delta);
+        if (!timezone)
+            return NULL;
+        cxoTransformTimezones[offset + CXO_TRANSFORM_MAX_TZ_OFFSET] =
+                timezone;
+    }
+    return timezone;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoTransform_getTypeInfo()
 //   Get type information for the specified transform. The transform number is
@@ -734,6 +907,13 @@ int cxoTransform_init(void)
         return -1;
     cxoPyTypeDate = PyDateTimeAPI->DateType;
     cxoPyTypeDateTime = PyDateTimeAPI->DateTimeType;
+    module = PyImport_ImportModule("datetime");
+    if (!module)
+        return -1;
+    cxoPyTypeTimezone = PyObject_GetAttrString(module, "timezone");
+    Py_DECREF(module);
+    if (!cxoPyTypeTimezone)
+        return -1;
 
     // import the decimal module for decimal support
     module = PyImport_ImportModule("decimal");
@@ -749,6 +929,38 @@ int cxoTransform_init(void)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoTransform_setTimezoneOffset()
+//   Set the time zone offset of the timestamp from an aware datetime. Naive
+// datetimes are left with an offset of zero.
+//-----------------------------------------------------------------------------
+static int cxoTransform_setTimezoneOffset(PyObject *value,
+        dpiTimestamp *timestamp)
+{
+    PyObject *delta;
+    int offset;
+
+    delta = PyObject_CallMethod(value, "utcoffset", NULL);
+    if (!delta)
+        return -1;
+    if (delta == Py_None) {
+        Py_DECREF(delta);
+        return 0;
+    }
+    if (!PyDelta_Check(delta)) {
+        Py_DECREF(delta);
+        PyErr_SetString(PyExc_TypeError, "expecting timedelta from utcoffset");
+        return -1;
+    }
+    offset = (PyDateTime_DELTA_GET_DAYS(delta) * 86400 +
+            PyDateTime_DELTA_GET_SECONDS(delta)) / 60;
+    Py_DECREF(delta);
+    timestamp->tzHourOffset = (int8_t) (offset / 60);
+    timestamp->tzMinuteOffset = (int8_t) (offset % 60);
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoTransform_timestampFromTicks()
 //   Creates a timestamp from ticks (number of seconds since Unix epoch).
@@ -759,6 +971,41 @@ PyObject *cxoTransform_timestampFromTicks(PyObject *args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoTransform_toDecimal()
+//   Return a decimal object for the number in text form returned by ODPI-C.
+// The text only ever contains ASCII characters, so unless the encoding
+// represents them differently (UTF-16) the string is created directly without
+// looking up a codec. The constructor is called with a prepared argument tuple
+// instead of a variable argument list.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toDecimal(dpiBytes *bytes)
+{
+    PyObject *stringObj, *args, *result;
+
+    if (cxoUtils_isAsciiCompatible(bytes->encoding)) {
+        stringObj = PyUnicode_New(bytes->length, 127);
+        if (!stringObj)
+            return NULL;
+        memcpy(PyUnicode_1BYTE_DATA(stringObj), bytes->ptr, bytes->length);
+    } else {
+        stringObj = PyUnicode_Decode(bytes->ptr, bytes->length,
+                cxoUtils_getAdjustedEncoding(bytes->encoding), NULL);
+        if (!stringObj)
+            return NULL;
+    }
+    args = PyTuple_New(1);
+    if (!args) {
+        Py_DECREF(stringObj);
+        return NULL;
+    }
+    PyTuple_SET_ITEM(args, 0, stringObj);
+    result = PyObject_Call((PyObject*) cxoPyTypeDecimal, args, NULL);
+    Py_DECREF(args);
+    return result;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoTransform_toPython()
 //   Transforms a database value into its corresponding Python object.
@@ -767,8 +1014,9 @@ PyObject *cxoTransform_toPython(cxoTransformNum transformNum,
         cxoConnection *connection, cxoObjectType *objType,
         dpiDataBuffer *dbValue, const char *encodingErrors)
 {
-    PyObject *stringObj, *result;
+    PyObject *stringObj, *result, *timezone;
     dpiIntervalDS *intervalDS;
+    int64_t epochValue;
     dpiTimestamp *timestamp;
     uint32_t rowidLength;
     cxoDbType *dbType;
@@ -814,6 +1062,26 @@ PyObject *cxoTransform_toPython(cxoTransformNum transformNum,
                     timestamp->month, timestamp->day, timestamp->hour,
                     timestamp->minute, timestamp->second,
                     timestamp->fsecond / 1000);
+        case CXO_TRANSFORM_EPOCH_MS:
+        case CXO_TRANSFORM_EPOCH_NS:
+        case CXO_TRANSFORM_EPOCH_S:
+        case CXO_TRANSFORM_EPOCH_US:
+            if (cxoUtils_getEpochTime(&dbValue->asTimestamp,
+                    cxoTransform_getEpochUnitsPerSecond(transformNum), 1,
+                    &epochValue) < 0)
+                return NULL;
+            return PyLong_FromLongLong(epochValue);
+        case CXO_TRANSFORM_TIMESTAMP_TZ_AWARE:
+            timestamp = &dbValue->asTimestamp;
+            timezone = cxoTransform_getTimezone(timestamp->tzHourOffset,
+                    timestamp->tzMinuteOffset);
+            if (!timezone)
+                return NULL;
+            return PyDateTimeAPI->DateTime_FromDateAndTime(timestamp->year,
+                    timestamp->month, timestamp->day, timestamp->hour,
+                    timestamp->minute, timestamp->second,
+                    timestamp->fsecond / 1000, timezone,
+                    PyDateTimeAPI->DateTimeType);
         case CXO_TRANSFORM_FIXED_NCHAR:
         case CXO_TRANSFORM_NSTRING:
             bytes = &dbValue->asBytes;
@@ -826,6 +1094,7 @@ PyObject *cxoTransform_toPython(cxoTransformNum transformNum,
         case CXO_TRANSFORM_NATIVE_INT:
             return PyLong_FromLongLong(dbValue->asInt64);
         case CXO_TRANSFORM_DECIMAL:
+            return cxoTransform_toDecimal(&dbValue->asBytes);
         case CXO_TRANSFORM_INT:
         case CXO_TRANSFORM_FLOAT:
             bytes = &dbValue->asBytes;
@@ -838,9 +1107,6 @@ PyObject *cxoTransform_toPython(cxoTransformNum transformNum,
                 result = PyNumber_Long(stringObj);
                 Py_DECREF(stringObj);
                 return result;
-            } else if (transformNum == CXO_TRANSFORM_DECIMAL) {
-                result = PyObject_CallFunctionObjArgs(
-                        (PyObject*) cxoPyTypeDecimal, stringObj, NULL);
             } else {
                 result = PyNumber_Float(stringObj);
             }
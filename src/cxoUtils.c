@@ -9,6 +9,10 @@
 
 #include "cxoModule.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 //-----------------------------------------------------------------------------
 // cxoUtils_formatString()
 //   Return a Python string formatted using the given format string and
@@ -79,6 +83,55 @@ int cxoUtils_getBooleanValue(PyObject *obj, int defaultValue, int *value)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoUtils_getDaysSinceEpoch()
+//   Return the number of days between 1970-01-01 and the given date in the
+// proleptic Gregorian calendar (negative for dates before the epoch).
+//-----------------------------------------------------------------------------
+int64_t cxoUtils_getDaysSinceEpoch(int year, int month, int day)
+{
+    int64_t era, yearOfEra, dayOfYear, dayOfEra;
+
+    year -= (month <= 2);
+    era = (year >= 0 ? year : year - 399) / 400;
+    yearOfEra = year - era * 400;
+    dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoUtils_getEpochTime()
+//   Return the time elapsed since 1970-01-01 00:00:00 for the given timestamp
+// in the given number of units per second (1 for seconds up to 1000000000 for
+// nanoseconds). If requested, the time zone offset of the timestamp is
+// subtracted so that the value is relative to UTC; otherwise any time zone is
+// ignored. An exception is raised if the value does not fit in 64 bits.
+//-----------------------------------------------------------------------------
+int cxoUtils_getEpochTime(dpiTimestamp *timestamp, int64_t unitsPerSecond,
+        int useTimeZone, int64_t *value)
+{
+    int64_t seconds;
+
+    seconds = cxoUtils_getDaysSinceEpoch(timestamp->year, timestamp->month,
+            timestamp->day) * 86400 + timestamp->hour * 3600 +
+            timestamp->minute * 60 + timestamp->second;
+    if (useTimeZone)
+        seconds -= timestamp->tzHourOffset * 3600 +
+                timestamp->tzMinuteOffset * 60;
+    if (seconds > INT64_MAX / unitsPerSecond - 1 ||
+            seconds < INT64_MIN / unitsPerSecond + 1) {
+        cxoError_raiseFromString(cxoDataErrorException,
+                "timestamp cannot be represented in the requested units");
+        return -1;
+    }
+    *value = seconds * unitsPerSecond +
+            timestamp->fsecond / (1000000000 / unitsPerSecond);
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoUtils_getModuleAndName()
 //   Return the module and name for the type.
@@ -98,6 +151,24 @@ int cxoUtils_getModuleAndName(PyTypeObject *type, PyObject **module,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoUtils_getMonotonicTime()
+//   Return the value of a monotonic clock, in milliseconds. Only differences
+// between values returned by this function are meaningful.
+//-----------------------------------------------------------------------------
+double cxoUtils_getMonotonicTime(void)
+{
+#ifdef _WIN32
+    return (double) GetTickCount64();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1000.0 + (double) ts.tv_nsec / 1000000.0;
+#endif
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoUtils_initializeDPI()
 //   Initialize the ODPI-C library. This is done when the first standalone
@@ -124,6 +195,18 @@ int cxoUtils_initializeDPI(void)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoUtils_isAsciiCompatible()
+//   Return whether or not the encoding represents ASCII characters with the
+// same single bytes as ASCII does. This is true for all encodings supported
+// by the Oracle client except UTF-16.
+//-----------------------------------------------------------------------------
+int cxoUtils_isAsciiCompatible(const char *encoding)
+{
+    return (!encoding || strncmp(encoding, "UTF-16", 6) != 0);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoUtils_processJsonArg()
 //   Process the argument which is expected to be either a string or bytes, or
@@ -190,3 +273,82 @@ int cxoUtils_processSodaDocArg(cxoSodaDatabase *db, PyObject *arg,
 
     return 0;
 }
+
+
+//-----------------------------------------------------------------------------
+// cxoUtils_setEpochTime()
+//   Set the timestamp from the time elapsed since 1970-01-01 00:00:00 in the
+// given number of units per second, using the proleptic Gregorian calendar.
+// The time zone offset is set to zero. An exception is raised if the
+// resulting date cannot be stored in the database.
+//-----------------------------------------------------------------------------
+int cxoUtils_setEpochTime(int64_t value, int64_t unitsPerSecond,
+        dpiTimestamp *timestamp)
+{
+    int64_t seconds, fraction, days, secondOfDay, era, dayOfEra, yearOfEra;
+    int64_t year, dayOfYear, monthPos;
+
+    // split the value into days, seconds of the day and fractional seconds;
+    // division is rounded towards negative infinity so that values before
+    // the epoch are handled correctly
+    seconds = value / unitsPerSecond;
+    fraction = value % unitsPerSecond;
+    if (fraction < 0) {
+        seconds--;
+        fraction += unitsPerSecond;
+    }
+    days = seconds / 86400;
+    secondOfDay = seconds % 86400;
+    if (secondOfDay < 0) {
+        days--;
+        secondOfDay += 86400;
+    }
+
+    // determine the year, month and day (inverse of the calculation found in
+    // cxoUtils_getDaysSinceEpoch())
+    days += 719468;
+    era = (days >= 0 ? days : days - 146096) / 146097;
+    dayOfEra = days - era * 146097;
+    yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 -
+            dayOfEra / 146096) / 365;
+    dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 -
+            yearOfEra / 100);
+    monthPos = (5 * dayOfYear + 2) / 153;
+    year = yearOfEra + era * 400 + (monthPos >= 10);
+    if (year < -4712 || year > 9999) {
+        cxoError_raiseFromString(cxoDataErrorException,
+                "epoch value is outside the range of supported dates");
+        return -1;
+    }
+
+    // populate the timestamp
+    memset(timestamp, 0, sizeof(dpiTimestamp));
+    timestamp->year = (int16_t) year;
+    timestamp->month = (uint8_t) (monthPos < 10 ? monthPos + 3 : monthPos - 9);
+    timestamp->day = (uint8_t) (dayOfYear - (153 * monthPos + 2) / 5 + 1);
+    timestamp->hour = (uint8_t) (secondOfDay / 3600);
+    timestamp->minute = (uint8_t) ((secondOfDay % 3600) / 60);
+    timestamp->second = (uint8_t) (secondOfDay % 60);
+    timestamp->fsecond = (uint32_t) (fraction *
+            (1000000000 / unitsPerSecond));
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoUtils_sleep()
+//   Suspend the calling thread for the given number of milliseconds. This is
+// expected to be called without the GIL.
+//-----------------------------------------------------------------------------
+void cxoUtils_sleep(uint32_t milliseconds)
+{
+#ifdef _WIN32
+    Sleep(milliseconds);
+#else
+    struct timespec ts;
+
+    ts.tv_sec = milliseconds / 1000;
+    ts.tv_nsec = (long) (milliseconds % 1000) * 1000000;
+    while (nanosleep(&ts, &ts) < 0 && errno == EINTR);
+#endif
+}
@@ -14,6 +14,14 @@
 
 #include "cxoModule.h"
 
+// when a variable must be grown to hold a larger value, its buffer size (in
+// bytes) is at least doubled, but doubling does not take the buffer size
+// beyond the largest size the type supports in SQL unless the value itself
+// requires it; larger buffers are bound as LONG or LONG RAW which results in
+// errors such as ORA-01461 when the statement is executed
+#define CXO_VAR_MAX_GROWTH_SIZE         4000
+#define CXO_VAR_MAX_GROWTH_SIZE_NCHAR   2000
+
 //-----------------------------------------------------------------------------
 // forward declaration of functions
 //-----------------------------------------------------------------------------
@@ -21,6 +29,7 @@ static void cxoVar_free(cxoVar*);
 static PyObject *cxoVar_repr(cxoVar*);
 static PyObject *cxoVar_externalCopy(cxoVar*, PyObject*);
 static PyObject *cxoVar_externalSetValue(cxoVar*, PyObject*);
+static PyObject *cxoVar_externalSetValues(cxoVar*, PyObject*);
 static PyObject *cxoVar_externalGetValue(cxoVar*, PyObject*, PyObject*);
 static PyObject *cxoVar_externalGetActualElements(cxoVar*, void*);
 static PyObject *cxoVar_externalGetValues(cxoVar*, void*);
@@ -36,6 +45,7 @@ static PyMemberDef cxoMembers[] = {
     { "numElements", T_INT, offsetof(cxoVar, allocatedElements),
             READONLY },
     { "outconverter", T_OBJECT, offsetof(cxoVar, outConverter), 0 },
+    { "scale", T_BYTE, offsetof(cxoVar, scale), READONLY },
     { "size", T_INT, offsetof(cxoVar, size), READONLY },
     { NULL }
 };
@@ -58,6 +68,7 @@ static PyGetSetDef cxoCalcMembers[] = {
 static PyMethodDef cxoVarMethods[] = {
     { "copy", (PyCFunction) cxoVar_externalCopy, METH_VARARGS },
     { "setvalue", (PyCFunction) cxoVar_externalSetValue, METH_VARARGS },
+    { "setvalues", (PyCFunction) cxoVar_externalSetValues, METH_VARARGS },
     { "getvalue", (PyCFunction) cxoVar_externalGetValue,
               METH_VARARGS  | METH_KEYWORDS },
     { NULL }
@@ -373,6 +384,7 @@ PyObject *cxoVar_getSingleValue(cxoVar *var, dpiData *data, uint32_t arrayPos)
     PyObject *value, *result;
     uint32_t numReturnedRows;
     dpiData *returnedData;
+    int64_t scaledValue;
 
     // handle DML returning
     if (!data && var->getReturnedData) {
@@ -388,7 +400,12 @@ PyObject *cxoVar_getSingleValue(cxoVar *var, dpiData *data, uint32_t arrayPos)
     else data = &var->data[arrayPos];
     if (data->isNull)
         Py_RETURN_NONE;
-    value = cxoTransform_toPython(var->transformNum, var->connection,
+    if (var->transformNum == CXO_TRANSFORM_SCALED_INT) {
+        if (cxoTransform_getScaledInt(&data->value.asBytes, var->scale,
+                &scaledValue) < 0)
+            return NULL;
+        value = PyLong_FromLongLong(scaledValue);
+    } else value = cxoTransform_toPython(var->transformNum, var->connection,
             var->objectType, &data->value, var->encodingErrors);
     if (value) {
         switch (var->transformNum) {
@@ -440,25 +457,48 @@ PyObject *cxoVar_getValue(cxoVar *var, uint32_t arrayPos)
 
 //-----------------------------------------------------------------------------
 // cxoVar_setValueBytes()
-//   Set a value in the variable from a byte string of some sort.
+//   Set a value in the variable from a byte string of some sort. If the value
+// does not fit in the variable, a new variable is created and the existing
+// values are copied to it. The new buffer size is at least double the old
+// buffer size (up to the limit for the type) so that a sequence of increasing
+// sizes (as is common with executemany()) only requires a logarithmic number
+// of reallocations instead of one reallocation per value. The growth is calculated in bytes; the size
+// of the variable continues to reflect the size of the largest value set.
+// Since bind variables are retained by the cursor across executions of the
+// same statement, the grown buffer is retained as well.
 //-----------------------------------------------------------------------------
 static int cxoVar_setValueBytes(cxoVar *var, uint32_t pos, dpiData *data,
         cxoBuffer *buffer)
 {
+    uint32_t i, numElements, newBufferSize, maxGrowthSize;
     dpiData *tempVarData, *sourceData;
     dpiOracleTypeNum oracleTypeNum;
     dpiNativeTypeNum nativeTypeNum;
-    uint32_t i, numElements;
     dpiVar *tempVarHandle;
     int status;
 
     if (buffer->size > var->bufferSize) {
         cxoTransform_getTypeInfo(var->transformNum, &oracleTypeNum,
                 &nativeTypeNum);
+        maxGrowthSize = CXO_VAR_MAX_GROWTH_SIZE;
+        if (oracleTypeNum == DPI_ORACLE_TYPE_NCHAR ||
+                oracleTypeNum == DPI_ORACLE_TYPE_NVARCHAR ||
+                oracleTypeNum == DPI_ORACLE_TYPE_RAW)
+            maxGrowthSize = CXO_VAR_MAX_GROWTH_SIZE_NCHAR;
+        newBufferSize = var->bufferSize * 2;
+        if (newBufferSize > maxGrowthSize)
+            newBufferSize = maxGrowthSize;
+        if (newBufferSize < buffer->size)
+            newBufferSize = buffer->size;
         if (dpiConn_newVar(var->connection->handle, oracleTypeNum,
-                nativeTypeNum, var->allocatedElements, buffer->size, 0,
+                nativeTypeNum, var->allocatedElements, newBufferSize, 1,
                 var->isArray, NULL, &tempVarHandle, &tempVarData) < 0)
             return cxoError_raiseAndReturnInt();
+        if (dpiVar_getSizeInBytes(tempVarHandle, &newBufferSize) < 0) {
+            cxoError_raiseAndReturnInt();
+            dpiVar_release(tempVarHandle);
+            return -1;
+        }
         if (var->isArray) {
             if (dpiVar_getNumElementsInArray(var->handle, &numElements) < 0) {
                 cxoError_raiseAndReturnInt();
@@ -486,8 +526,9 @@ static int cxoVar_setValueBytes(cxoVar *var, uint32_t pos, dpiData *data,
         dpiVar_release(var->handle);
         var->handle = tempVarHandle;
         var->data = tempVarData;
-        var->size = buffer->numCharacters;
-        var->bufferSize = buffer->size;
+        if (buffer->numCharacters > var->size)
+            var->size = buffer->numCharacters;
+        var->bufferSize = newBufferSize;
     }
     status = dpiVar_setFromBytes(var->handle, pos, buffer->ptr, buffer->size);
     if (status < 0)
@@ -676,6 +717,105 @@ static PyObject *cxoVar_externalSetValue(cxoVar *var, PyObject *args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoVar_setEpochValues()
+//   Set consecutive values of the variable directly from a buffer of 64-bit
+// integers containing the time elapsed since the epoch. No Python objects are
+// created for the values.
+//-----------------------------------------------------------------------------
+static int cxoVar_setEpochValues(cxoVar *var, uint32_t pos, Py_buffer *view)
+{
+    int64_t unitsPerSecond, *values;
+    const char *format;
+    Py_ssize_t i, numValues;
+    dpiData *data;
+
+    // verify the buffer contains native 64-bit integers
+    format = (view->format) ? view->format : "B";
+    if (*format == '@' || *format == '=')
+        format++;
+    if (view->itemsize != sizeof(int64_t) ||
+            (strcmp(format, "q") != 0 && strcmp(format, "l") != 0)) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "expecting buffer of native 64-bit integers");
+        return -1;
+    }
+    numValues = view->len / view->itemsize;
+    if ((Py_ssize_t) pos + numValues > (Py_ssize_t) var->allocatedElements) {
+        PyErr_SetString(PyExc_IndexError,
+                "cxoVar_setEpochValues: array size exceeded");
+        return -1;
+    }
+
+    // convert the values
+    values = (int64_t*) view->buf;
+    unitsPerSecond = cxoTransform_getEpochUnitsPerSecond(var->transformNum);
+    for (i = 0; i < numValues; i++) {
+        data = &var->data[pos + i];
+        data->isNull = 0;
+        if (cxoUtils_setEpochTime(values[i], unitsPerSecond,
+                &data->value.asTimestamp) < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_externalSetValues()
+//   Set consecutive values of the variable, starting at the given position.
+// Variables which store the time elapsed since the epoch also accept a buffer
+// of 64-bit integers, which is converted without creating Python objects.
+//-----------------------------------------------------------------------------
+static PyObject *cxoVar_externalSetValues(cxoVar *var, PyObject *args)
+{
+    PyObject *values, *sequence;
+    Py_ssize_t i, numValues;
+    Py_buffer view;
+    uint32_t pos;
+    int status;
+
+    // parse arguments
+    if (!PyArg_ParseTuple(args, "iO", &pos, &values))
+        return NULL;
+    if (var->isArray)
+        return cxoError_raiseFromString(cxoNotSupportedErrorException,
+                "use setvalue() to set the values of PL/SQL arrays");
+    var->isValueSet = 1;
+
+    // buffers of integers are converted directly, if applicable
+    if (cxoTransform_getEpochUnitsPerSecond(var->transformNum) > 0 &&
+            PyObject_CheckBuffer(values) &&
+            (!var->inConverter || var->inConverter == Py_None)) {
+        if (PyObject_GetBuffer(values, &view,
+                PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0)
+            return NULL;
+        status = cxoVar_setEpochValues(var, pos, &view);
+        PyBuffer_Release(&view);
+        if (status < 0)
+            return NULL;
+        Py_RETURN_NONE;
+    }
+
+    // otherwise, set each value in the sequence in turn
+    sequence = PySequence_Fast(values, "expecting sequence or buffer");
+    if (!sequence)
+        return NULL;
+    numValues = PySequence_Fast_GET_SIZE(sequence);
+    for (i = 0; i < numValues; i++) {
+        if (cxoVar_setSingleValue(var, pos + (uint32_t) i,
+                PySequence_Fast_GET_ITEM(sequence, i)) < 0) {
+            Py_DECREF(sequence);
+            return NULL;
+        }
+    }
+    Py_DECREF(sequence);
+
+    Py_RETURN_NONE;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoVar_externalGetValue()
 //   Return the value of the variable at the given position.
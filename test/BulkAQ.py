@@ -99,6 +99,64 @@ class TestCase(TestEnv.BaseTestCase):
         self.connection.commit()
         self.assertEqual(allData, RAW_PAYLOAD_DATA)
 
+    def testDeqManyRaw(self):
+        "test bulk dequeue into a single buffer"
+        queue = self.__getAndClearRawQueue()
+        messages = [self.connection.msgproperties(payload=d) \
+                for d in RAW_PAYLOAD_DATA]
+        queue.enqMany(messages)
+        payloads, offsets, msgids = \
+                queue.deqManyRaw(len(RAW_PAYLOAD_DATA), msgids=True)
+        self.connection.commit()
+        self.assertEqual(len(offsets), len(RAW_PAYLOAD_DATA) + 1)
+        self.assertEqual(len(msgids), len(RAW_PAYLOAD_DATA))
+        data = [payloads[offsets[i]:offsets[i + 1]].decode( \
+                self.connection.encoding) for i in range(len(offsets) - 1)]
+        self.assertEqual(data, RAW_PAYLOAD_DATA)
+        payloads, offsets, msgids = queue.deqManyRaw(5)
+        self.assertEqual(payloads, b"")
+        self.assertEqual(list(offsets), [0])
+        self.assertEqual(msgids, None)
+
+    def testEnqManyRaw(self):
+        "test bulk enqueue from buffers and from a buffer with offsets"
+        queue = self.__getAndClearRawQueue()
+        encoding = self.connection.encoding
+        buffers = [memoryview(d.encode(encoding)) for d in RAW_PAYLOAD_DATA]
+        queue.enqManyRaw(buffers)
+        payloads, offsets, msgids = queue.deqManyRaw(len(RAW_PAYLOAD_DATA))
+        queue.enqManyRaw(payloads, offsets)
+        messages = queue.deqMany(len(RAW_PAYLOAD_DATA))
+        self.connection.commit()
+        data = [m.payload.decode(encoding) for m in messages]
+        self.assertEqual(data, RAW_PAYLOAD_DATA)
+        self.assertRaises(cx_Oracle.ProgrammingError, queue.enqManyRaw,
+                b"abc", [0, 5])
+
+    def testConsume(self):
+        "test consuming messages in batches with a callback"
+        queue = self.__getAndClearRawQueue()
+        messages = [self.connection.msgproperties(payload=d) \
+                for d in RAW_PAYLOAD_DATA]
+        queue.enqMany(messages)
+        self.connection.commit()
+        batches = []
+        def callback(messages):
+            batches.append([m.payload.decode(self.connection.encoding) \
+                    for m in messages])
+        numConsumed = queue.consume(callback, batchSize=5,
+                maxWait=cx_Oracle.DEQ_NO_WAIT, maxBatchLatency=0,
+                autocommit=True)
+        self.assertEqual(numConsumed, len(RAW_PAYLOAD_DATA))
+        self.assertEqual([len(b) for b in batches], [5, 5, 2])
+        self.assertEqual(sum(batches, []), RAW_PAYLOAD_DATA)
+        self.assertEqual(queue.deqOptions.wait, cx_Oracle.DEQ_NO_WAIT)
+        queue.enqMany(messages)
+        numConsumed = queue.consume(lambda m: False, batchSize=5,
+                maxWait=cx_Oracle.DEQ_NO_WAIT, maxBatchLatency=0)
+        self.assertEqual(numConsumed, 5)
+        self.connection.rollback()
+
     def testEnqAndDeqVisibility(self):
         "test visibility option for enqueue and dequeue"
         queue = self.__getAndClearRawQueue()
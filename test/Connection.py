@@ -368,6 +368,125 @@ class TestCase(TestEnv.BaseTestCase):
         count, = cursor.fetchone()
         self.assertEqual(count, 0)
 
+    def testSplitTable(self):
+        "test splitting a table into ROWID ranges"
+        connection = TestEnv.GetConnection()
+        ranges = connection.split_table(TestEnv.GetMainUser().upper(),
+                "TESTNUMBERS", 4)
+        self.assertTrue(len(ranges) > 0)
+        cursor = connection.cursor()
+        numRows = 0
+        for startRowid, endRowid in ranges:
+            cursor.execute("""
+                    select count(*)
+                    from TestNumbers
+                    where rowid between :1 and :2""",
+                    (startRowid, endRowid))
+            count, = cursor.fetchone()
+            numRows += count
+        self.assertEqual(numRows, 10)
+        self.assertRaises(cx_Oracle.ProgrammingError, connection.split_table,
+                "A", "B", 0)
+
+    def testResultCache(self):
+        "test caching the results of queries on the client"
+        connection = TestEnv.GetConnection()
+        cursor = connection.cursor()
+        cursor.execute("truncate table TestTempTable")
+        cursor.execute("insert into TestTempTable (IntCol) values (1)")
+        connection.commit()
+        sql = "select IntCol from TestTempTable"
+        self.assertEqual(connection.cachedquery(sql), [(1,)])
+        cursor.execute("insert into TestTempTable (IntCol) values (2)")
+        connection.commit()
+        self.assertEqual(connection.cachedquery(sql), [(1,), (2,)])
+        connection.resultcachesize = 1
+        self.assertRaises(cx_Oracle.ProgrammingError, connection.cachedquery,
+                sql)
+        connection.resultcachetimeout = 60
+        rows = connection.cachedquery(sql)
+        rows.append((3,))
+        cursor.execute("delete from TestTempTable where IntCol = 2")
+        connection.commit()
+        self.assertEqual(connection.cachedquery(sql), [(1,), (2,)])
+        otherSql = "select IntCol from TestNumbers where IntCol <= :val"
+        self.assertEqual(connection.cachedquery(otherSql, dict(val=2)),
+                [(1,), (2,)])
+        self.assertEqual(connection.cachedquery(sql), [(1,)])
+        cursor.execute("insert into TestTempTable (IntCol) values (2)")
+        connection.commit()
+        connection.clearresultcache()
+        self.assertEqual(connection.cachedquery(sql), [(1,), (2,)])
+        self.assertEqual(connection.resultcachesubscr, None)
+        self.assertRaises(TypeError, setattr, connection,
+                "resultcachesubscr", "bad value")
+
+    def testExecuteBatch(self):
+        "test executing a batch of statements"
+        connection = TestEnv.GetConnection()
+        cursor = connection.cursor()
+        cursor.execute("truncate table TestTempTable")
+        results = connection.execute_batch([
+                ("insert into TestTempTable (IntCol) values (:1)", [1]),
+                ("insert into TestTempTable (IntCol) values (:val)",
+                        dict(val=2)),
+                ("select IntCol from TestNumbers where IntCol < :1", (3,)),
+                "select ':1', count(*) from TestTempTable",
+                ("update TestTempTable set StringCol = :val "
+                        "where IntCol <= :val", dict(val="2"))])
+        self.assertEqual(results, [1, 1, [(1,), (2,)], [(":1", 2)], 2])
+        results = connection.execute_batch([
+                "select count(*) from TestTempTable",
+                "truncate table TestTempTable",
+                "select count(*) from TestTempTable"])
+        self.assertEqual(results, [[(2,)], 0, [(0,)]])
+        self.assertRaises(TypeError, connection.execute_batch, [1])
+
+    def testGroupCommit(self):
+        "test coalescing commits with group_commit()"
+        connection = TestEnv.GetConnection(threaded=True)
+        connection.groupcommitwindow = 50
+        connection.groupcommitsize = 3
+        cursor = connection.cursor()
+        cursor.execute("truncate table TestTempTable")
+        futures = []
+        for i in range(3):
+            cursor.execute("insert into TestTempTable (IntCol) values (:1)",
+                    [i])
+            futures.append(connection.group_commit())
+        for future in futures:
+            self.assertEqual(future.result(timeout=10), None)
+        otherConnection = TestEnv.GetConnection()
+        otherCursor = otherConnection.cursor()
+        otherCursor.execute("select count(*) from TestTempTable")
+        count, = otherCursor.fetchone()
+        self.assertEqual(count, 3)
+        connection.close()
+        self.assertRaises(cx_Oracle.InterfaceError, connection.group_commit)
+
+    def testGroupCommitRollback(self):
+        "test group_commit() followed by commit() and rollback()"
+        connection = TestEnv.GetConnection(threaded=True)
+        connection.groupcommitwindow = 60000
+        cursor = connection.cursor()
+        cursor.execute("truncate table TestTempTable")
+        cursor.execute("insert into TestTempTable (IntCol) values (1)")
+        future = connection.group_commit()
+        connection.commit()
+        self.assertEqual(future.result(timeout=10), None)
+        cursor.execute("insert into TestTempTable (IntCol) values (2)")
+        future = connection.group_commit()
+        connection.rollback()
+        self.assertRaises(cx_Oracle.InterfaceError, future.result, 10)
+        cursor.execute("insert into TestTempTable (IntCol) values (3)")
+        otherConnection = TestEnv.GetConnection()
+        otherCursor = otherConnection.cursor()
+        otherCursor.execute("select IntCol from TestTempTable")
+        self.assertEqual(otherCursor.fetchall(), [(1,)])
+        future = connection.group_commit()
+        connection.close()
+        self.assertRaises(cx_Oracle.InterfaceError, future.result, 10)
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 
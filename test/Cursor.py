@@ -12,8 +12,11 @@
 import TestEnv
 
 import cx_Oracle
+import datetime
 import decimal
+import mmap
 import sys
+import tempfile
 
 class TestCase(TestEnv.BaseTestCase):
 
@@ -698,5 +701,147 @@ class TestCase(TestEnv.BaseTestCase):
         result, = self.cursor.fetchone()
         self.assertEqual(result, expectedResult)
 
+    def testAdaptiveFetchSize(self):
+        "test fetching with buffers smaller than the declared column size"
+        self.cursor.execute("truncate table TestTempTable")
+        data = [(i, "X" * (10 if i < 5 else i * 30)) for i in range(1, 11)]
+        self.cursor.executemany("""
+                insert into TestTempTable (IntCol, StringCol)
+                values (:1, :2)""", data)
+        self.connection.commit()
+        self.cursor.arraysize = 3
+        sql = "select IntCol, StringCol from TestTempTable order by IntCol"
+        shortSql = sql + " fetch first 4 rows only"
+        self.cursor.execute(shortSql)
+        self.assertEqual(self.cursor.fetchvars[1].size, 400)
+        self.cursor.adaptivefetchsize = 50
+        self.cursor.execute(shortSql)
+        self.assertEqual(self.cursor.fetchvars[1].size, 50)
+        self.assertEqual(self.cursor.fetchall(), data[:4])
+        self.cursor.execute(sql)
+        self.assertEqual(self.cursor.fetchvars[1].size, 50)
+        self.assertEqual(self.cursor.fetchall(), data)
+        self.assertEqual(self.cursor.fetchvars[1].size, 400)
+        self.cursor.execute(sql)
+        self.assertEqual(self.cursor.fetchvars[1].size, 400)
+        self.assertEqual(self.cursor.fetchall(), data)
+        self.cursor.execute(sql + " desc")
+        self.assertEqual(self.cursor.fetchvars[1].size, 50)
+        self.assertEqual(self.cursor.fetchone(), data[-1])
+        self.assertEqual(self.cursor.fetchall(), data[-2::-1])
+
+    def testAutoArraySize(self):
+        "test that the fetch array size is tuned for subsequent executions"
+        sql = "select IntCol from TestNumbers order by IntCol"
+        self.cursor.autoarraysize = True
+        self.cursor.arraysize = 100
+        self.cursor.execute(sql)
+        self.assertEqual(self.cursor.fetchvars[0].numElements, 100)
+        expectedData = self.cursor.fetchall()
+        self.assertEqual(len(expectedData), 10)
+        cursor = self.connection.cursor()
+        cursor.autoarraysize = True
+        cursor.execute(sql)
+        self.assertEqual(cursor.fetchvars[0].numElements, 13)
+        self.assertEqual(cursor.fetchall(), expectedData)
+
+    def testPreparedStatement(self):
+        "test executing a prepared statement many times"
+        stmt = self.connection.prepare_statement("""
+                select IntCol
+                from TestNumbers
+                where IntCol between :low and :high
+                order by IntCol""")
+        self.assertTrue(isinstance(stmt, cx_Oracle.Cursor))
+        self.assertEqual(stmt.execute(low=2, high=3).fetchall(), [(2,), (3,)])
+        fetchVars = stmt.fetchvars
+        self.assertEqual(stmt.execute(dict(low=5, high=6)).fetchall(),
+                [(5,), (6,)])
+        self.assertTrue(stmt.fetchvars is fetchVars)
+        self.assertEqual([r for r, in stmt.execute([9, 20])], [9, 10])
+        self.assertRaises(cx_Oracle.ProgrammingError, stmt.prepare,
+                "select 1 from dual")
+        stmt = cx_Oracle.PreparedStatement(self.connection,
+                "insert into TestTempTable (IntCol) values (:1)")
+        self.cursor.execute("truncate table TestTempTable")
+        self.assertEqual(stmt.execute([1]), None)
+        stmt.executemany([(2,), (3,)])
+        self.cursor.execute("select count(*) from TestTempTable")
+        count, = self.cursor.fetchone()
+        self.assertEqual(count, 3)
+
+    def testFetchSerialized(self):
+        "test fetching rows in serialized form"
+        for sql in ("select * from TestNumbers order by IntCol",
+                "select * from TestStrings order by IntCol",
+                "select * from TestDates order by IntCol",
+                "select * from TestTimestamps order by IntCol"):
+            self.cursor.execute(sql)
+            expectedRows = self.cursor.fetchall()
+            self.cursor.execute(sql)
+            data = self.cursor.fetch_serialized()
+            self.assertTrue(isinstance(data, bytes))
+            self.assertEqual(cx_Oracle.load_serialized(data), expectedRows)
+        self.cursor.execute("select IntCol from TestNumbers order by IntCol")
+        data = self.cursor.fetch_serialized(numRows=3)
+        self.assertEqual(cx_Oracle.load_serialized(data), [(1,), (2,), (3,)])
+        self.assertEqual(self.cursor.rowcount, 3)
+        data = self.cursor.fetch_serialized()
+        self.assertEqual(len(cx_Oracle.load_serialized(data)), 7)
+        self.assertRaises(cx_Oracle.ProgrammingError,
+                cx_Oracle.load_serialized, data[:-1])
+        self.assertRaises(cx_Oracle.ProgrammingError,
+                cx_Oracle.load_serialized, b"not serialized data")
+        self.cursor.execute("select CLOBCol from TestCLOBs")
+        self.assertRaises(cx_Oracle.NotSupportedError,
+                self.cursor.fetch_serialized)
+
+    def testFetchColumns(self):
+        "test fetching rows as columns for sharing between processes"
+        sql = """
+                select IntCol, NumberCol, UnconstrainedCol
+                from TestNumbers
+                order by IntCol"""
+        self.cursor.execute(sql)
+        expectedRows = self.cursor.fetchall()
+        self.cursor.execute(sql)
+        columns = cx_Oracle.open_columns(self.cursor.fetch_columns())
+        self.assertEqual([(c.name, c.kind) for c in columns],
+                [("INTCOL", "int64"), ("NUMBERCOL", "double"),
+                 ("UNCONSTRAINEDCOL", "double")])
+        for i, column in enumerate(columns):
+            self.assertEqual(column.offsets, None)
+            self.assertEqual(column.scale, 0)
+            self.assertEqual([v if n else None \
+                    for v, n in zip(column.data, column.nulls)],
+                    [r[i] for r in expectedRows])
+        sql = """
+                select StringCol, DateCol
+                from TestStrings s
+                    join TestDates d on d.IntCol = s.IntCol
+                order by s.IntCol"""
+        self.cursor.execute(sql)
+        expectedRows = self.cursor.fetchall()
+        self.cursor.execute(sql)
+        with tempfile.TemporaryFile() as f:
+            f.write(self.cursor.fetch_columns())
+            f.flush()
+            sharedData = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        stringColumn, dateColumn = cx_Oracle.open_columns(sharedData)
+        self.assertEqual(stringColumn.kind, "string")
+        self.assertTrue(stringColumn.data.readonly)
+        offsets = stringColumn.offsets
+        self.assertEqual([bytes(stringColumn.data[offsets[i]:offsets[i + 1]])
+                .decode() for i in range(len(stringColumn.nulls))],
+                [r[0] for r in expectedRows])
+        self.assertEqual(dateColumn.kind, "datetime")
+        epoch = datetime.datetime(1970, 1, 1)
+        self.assertEqual([epoch + datetime.timedelta(microseconds=v)
+                for v in dateColumn.data], [r[1] for r in expectedRows])
+        self.assertRaises(cx_Oracle.ProgrammingError,
+                cx_Oracle.open_columns, b"not columnar data")
+        self.cursor.execute("select NullableCol from TestNumbers")
+        self.assertRaises(cx_Oracle.DataError, self.cursor.fetch_columns)
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
@@ -129,6 +129,16 @@ class TestCase(TestEnv.BaseTestCase):
         outValue, = cursor.fetchone()
         self.assertEqual(outValue, value)
 
+    def testBindNumberFormats(self):
+        "test binding integers and floats of various sizes as numbers"
+        values = [0, -1, 2 ** 63 - 1, -2 ** 63, 2 ** 70, -2 ** 70, 0.1, -2.5,
+                1e16, 1.5e-100]
+        for value in values:
+            self.cursor.setinputsizes(value=cx_Oracle.DB_TYPE_NUMBER)
+            self.cursor.execute("select :value from dual", value=value)
+            fetchedValue, = self.cursor.fetchone()
+            self.assertEqual(fetchedValue, value)
+
     def testBindNull(self):
         "test binding in a null"
         self.cursor.execute("""
@@ -398,6 +408,50 @@ class TestCase(TestEnv.BaseTestCase):
         value, = self.cursor.fetchone()
         self.assertEqual(str(value), str(float("NaN")))
 
+    def testFetchDecimal(self):
+        "test fetching fixed point numbers as decimals"
+        def handler(cursor, name, defaultType, size, precision, scale):
+            if defaultType == cx_Oracle.DB_TYPE_NUMBER:
+                return cursor.var(decimal.Decimal, arraysize=cursor.arraysize)
+        self.cursor.outputtypehandler = handler
+        values = ["0", "1234567890123456.78", "-0.05", "12.5",
+                "-9999999999999999.99", "1e-130", "9.99999999999999e+125"]
+        for value in values:
+            self.cursor.execute("select to_number(:1) from dual", [value])
+            fetchedValue, = self.cursor.fetchone()
+            self.assertTrue(isinstance(fetchedValue, decimal.Decimal))
+            self.assertEqual(fetchedValue, decimal.Decimal(value))
+        self.cursor.execute("select cast(12.5 as number(18, 2)) from dual")
+        self.assertEqual(self.cursor.fetchone(), (decimal.Decimal("12.5"),))
+
+    def testFetchScaledInt(self):
+        "test fetching fixed point numbers as scaled integers"
+        def handler(cursor, name, defaultType, size, precision, scale):
+            if name == "NUMBERCOL":
+                return cursor.var(cx_Oracle.SCALED_INT,
+                        arraysize=cursor.arraysize)
+        self.cursor.outputtypehandler = handler
+        self.cursor.execute("""
+                select IntCol, NumberCol
+                from TestNumbers
+                order by IntCol""")
+        self.assertEqual(self.cursor.fetchvars[1].scale, 2)
+        self.assertEqual(self.cursor.fetchall(),
+                [(i, int(i * 125)) for i in range(1, 11)])
+        self.cursor.execute("""
+                select cast(-123.4 as number(18, 3)) NumberCol
+                from dual""")
+        self.assertEqual(self.cursor.fetchone(), (-123400,))
+        self.cursor.execute("""
+                select NumberCol, NumberCol
+                from TestNumbers
+                where IntCol = 3""")
+        column = cx_Oracle.open_columns(self.cursor.fetch_columns())[0]
+        self.assertEqual((column.kind, column.scale, list(column.data)),
+                ("int64", 2, [375]))
+        self.assertRaises(cx_Oracle.NotSupportedError, self.cursor.execute,
+                "select 1.5 NumberCol from dual")
+
     def testFetchNativeInt(self):
         "test fetching numbers as native integers"
         self.cursor.outputtypehandler = self.outputTypeHandlerNativeInt
@@ -369,6 +369,64 @@ class TestCase(TestEnv.BaseTestCase):
         arrayObj.trim(1)
         self.assertEqual(self.__GetObjectAsTuple(arrayObj), [])
 
+    def testBulkObjectConstruction(self):
+        "test creating objects and collections from rows"
+        subObjType = self.connection.gettype("UDT_SUBOBJECT")
+        arrayType = self.connection.gettype("UDT_OBJECTARRAY")
+        objs = subObjType.newobjects([(1, "AB"),
+                dict(SUBNUMBERVALUE=2, SubStringValue="CDE"), (3,)])
+        self.assertEqual([self.__GetObjectAsTuple(o) for o in objs],
+                [(1, "AB"), (2, "CDE"), (3, None)])
+        data = [(1, "AB"), (2, "CDE"), (3, "FGH")]
+        arrayObj = arrayType.from_rows(data)
+        self.assertEqual(self.__GetObjectAsTuple(arrayObj), data)
+        arrayObj = arrayType.from_rows([objs[0], dict(SUBNUMBERVALUE=4)])
+        self.assertEqual(self.__GetObjectAsTuple(arrayObj),
+                [(1, "AB"), (4, None)])
+        objType = self.connection.gettype("UDT_OBJECT")
+        obj, = objType.newobjects([dict(NUMBERVALUE=5,
+                SUBOBJECTVALUE=(6, "Sub"), SUBOBJECTARRAY=data[:2])])
+        self.assertEqual(obj.NUMBERVALUE, 5)
+        self.assertEqual(self.__GetObjectAsTuple(obj.SUBOBJECTVALUE),
+                (6, "Sub"))
+        self.assertEqual(self.__GetObjectAsTuple(obj.SUBOBJECTARRAY),
+                data[:2])
+        self.assertRaises(AttributeError, subObjType.newobjects,
+                [dict(INVALIDATTR=1)])
+        self.assertRaises(TypeError, subObjType.newobjects, [(1, "A", 2)])
+        self.assertRaises(cx_Oracle.ProgrammingError, subObjType.from_rows,
+                data)
+
+    def testObjectToDict(self):
+        "test converting an object to native Python values"
+        self.cursor.execute("""
+                select ObjectCol
+                from TestObjects
+                where IntCol = 1""")
+        obj, = self.cursor.fetchone()
+        result = obj.todict()
+        self.assertEqual(sorted(result.keys()),
+                sorted(a.name for a in obj.type.attributes))
+        self.assertEqual(result["NUMBERVALUE"], 1)
+        self.assertEqual(result["STRINGVALUE"], "First row")
+        self.assertEqual(result["SUBOBJECTVALUE"],
+                dict(SUBNUMBERVALUE=11, SUBSTRINGVALUE="Sub object 1"))
+        self.assertEqual(result["SUBOBJECTARRAY"],
+                [dict(SUBNUMBERVALUE=5, SUBSTRINGVALUE="first element"),
+                 dict(SUBNUMBERVALUE=6, SUBSTRINGVALUE="second element")])
+        result = obj.todict(recursive=False)
+        self.assertTrue(isinstance(result["SUBOBJECTVALUE"],
+                cx_Oracle.Object))
+        self.assertEqual(obj.SUBOBJECTARRAY.todict(recursive=False)[1],
+                dict(SUBNUMBERVALUE=6, SUBSTRINGVALUE="second element"))
+
+    def testCollectionToDictWithGrowingNumbers(self):
+        "test converting a collection of numbers of increasing length"
+        typeObj = self.connection.gettype("UDT_ARRAY")
+        values = [5, 123, 98765, 1234567.25]
+        obj = typeObj.newobject(values)
+        self.assertEqual(obj.todict(), values)
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 
@@ -13,6 +13,7 @@ import TestEnv
 
 import cx_Oracle
 import threading
+import time
 
 class TestCase(TestEnv.BaseTestCase):
 
@@ -162,6 +163,45 @@ class TestCase(TestEnv.BaseTestCase):
         for thread in threads:
             thread.join()
 
+    def testParallelFetch(self):
+        "test fetching a query in parallel using pooled connections"
+        pool = TestEnv.GetPool(min=2, max=4, increment=1, threaded=True,
+                getmode=cx_Oracle.SPOOL_ATTRVAL_WAIT)
+        sql = """
+                select IntCol, StringCol
+                from TestStrings
+                where IntCol between :1 and :2"""
+        bindSets = [(1, 3), (4, 6), (7, 10)]
+        rows = []
+        def consumer(columns):
+            self.assertEqual(len(columns), 2)
+            rows.extend(zip(*columns))
+        numRows = pool.parallel_fetch(sql, bindSets, consumer, arraysize=2)
+        self.assertEqual(numRows, 10)
+        self.assertEqual(sorted(rows),
+                [(i, "String %d" % i) for i in range(1, 11)])
+        self.assertEqual(pool.busy, 0)
+
+    def testWarmupThreads(self):
+        "test warming the pool concurrently"
+        pool = TestEnv.GetPool(min=6, max=10, increment=1, threaded=True,
+                getmode=cx_Oracle.SPOOL_ATTRVAL_WAIT, warmupThreads=3)
+        self.assertEqual(pool.min, 6)
+        self.assertEqual(pool.opened, 6)
+        self.assertEqual(pool.busy, 0)
+        self.assertEqual(pool.warm(8, threads=2, wait=True), 8)
+        self.assertEqual(pool.opened, 8)
+        self.assertEqual(pool.busy, 0)
+        self.assertEqual(pool.warm(4, wait=True), 8)
+        self.assertEqual(pool.warm(12, threads=4), None)
+        for i in range(50):
+            if pool.opened >= 10 and pool.busy == 0:
+                break
+            time.sleep(0.1)
+        self.assertEqual(pool.opened, 10)
+        self.assertEqual(pool.busy, 0)
+        self.assertEqual(pool.warm(10, wait=True), 10)
+
     def testPurity(self):
         """test session pool with various types of purity"""
         action = "TEST_ACTION"
@@ -372,6 +372,35 @@ class TestCase(TestEnv.BaseTestCase):
         self.assertEqual(self.cursor.fetchall(),
                 [(1, shortString), (2, longString)])
 
+    def testExecuteManyWithIncreasingSizes(self):
+        "test executemany() with strings of increasing size"
+        self.cursor.execute("truncate table TestTempTable")
+        data = [(i, "X" * i) for i in range(1, 301)]
+        self.cursor.executemany("""
+                insert into TestTempTable (IntCol, StringCol)
+                values (:1, :2)""", data)
+        self.connection.commit()
+        self.cursor.execute("""
+                select IntCol, StringCol
+                from TestTempTable
+                order by IntCol""")
+        self.assertEqual(self.cursor.fetchall(), data)
+
+    def testGrowthOfVariable(self):
+        "test that variables grow geometrically up to 4000 bytes"
+        var = self.cursor.var(str, 10)
+        bufferSizes = [var.bufferSize]
+        for i in range(11, 3001):
+            var.setvalue(0, "X" * i)
+            if var.bufferSize != bufferSizes[-1]:
+                bufferSizes.append(var.bufferSize)
+        self.assertLessEqual(len(bufferSizes), 10)
+        self.assertLessEqual(bufferSizes[-1], 4000)
+        self.assertEqual(var.getvalue(), "X" * 3000)
+        var.setvalue(0, "X" * 5000)
+        self.assertEqual(var.bufferSize, 5000)
+        self.assertEqual(var.getvalue(), "X" * 5000)
+
     def testIssue50(self):
         "test issue 50 - avoid error ORA-24816"
         cursor = self.connection.cursor()
@@ -109,6 +109,95 @@ class TestCase(TestEnv.BaseTestCase):
                 (TestEnv.GetMainUser(), TestEnv.GetConnectString())
         self.assertEqual(str(sub), expectedValue)
 
+    def testBufferedSubscription(self):
+        "test Subscription with buffered and coalesced notifications"
+
+        # skip if running on the Oracle Cloud, which does not support
+        # subscriptions currently
+        if self.isOnOracleCloud():
+            self.skipTest("Oracle Cloud does not support subscriptions " \
+                    "currently")
+
+        # truncate table in order to run test in known state
+        self.cursor.execute("truncate table TestTempTable")
+
+        # set up subscription
+        numInserts = 5
+        data = SubscriptionData(1)
+        connection = TestEnv.GetConnection(threaded=True, events=True)
+        sub = connection.subscribe(callback = data.CallbackHandler,
+                timeout = 10, qos = cx_Oracle.SUBSCR_QOS_ROWIDS,
+                bufferSize = 10, coalesceWindow = 2000)
+        self.assertEqual(sub.bufferSize, 10)
+        self.assertEqual(sub.coalesceWindow, 2000)
+        sub.registerquery("select * from TestTempTable")
+        connection.autocommit = True
+        cursor = connection.cursor()
+
+        # perform a number of inserts within the coalescing window
+        for i in range(numInserts):
+            cursor.execute("""
+                    insert into TestTempTable (IntCol, StringCol)
+                    values (:1, 'test')""", [i + 1])
+
+        # wait for the messages to be sent
+        data.condition.acquire()
+        data.condition.wait(10)
+        connection.unsubscribe(sub)
+
+        # verify the notifications were coalesced
+        self.assertEqual(sub.droppedEvents, 0)
+        self.assertEqual(data.numMessagesReceived + sub.coalescedEvents,
+                numInserts)
+        for operation in data.tableOperations:
+            self.assertTrue(operation & cx_Oracle.OPCODE_INSERT)
+
+    def testRowsAfterConnectionClosed(self):
+        "test accessing message rows after the connection has been closed"
+
+        # skip if running on the Oracle Cloud, which does not support
+        # subscriptions currently
+        if self.isOnOracleCloud():
+            self.skipTest("Oracle Cloud does not support subscriptions " \
+                    "currently")
+
+        # truncate table in order to run test in known state
+        self.cursor.execute("truncate table TestTempTable")
+
+        # set up subscription; the callback retains the tables without
+        # accessing their rows
+        tables = []
+        condition = threading.Condition()
+        def callback(message):
+            if message.type == cx_Oracle.EVENT_OBJCHANGE:
+                tables.extend(message.tables)
+                with condition:
+                    condition.notify()
+        connection = TestEnv.GetConnection(threaded=True, events=True)
+        sub = connection.subscribe(callback = callback, timeout = 10,
+                qos = cx_Oracle.SUBSCR_QOS_ROWIDS)
+        sub.registerquery("select * from TestTempTable")
+        connection.autocommit = True
+        cursor = connection.cursor()
+
+        # insert a row and wait for the notification
+        with condition:
+            cursor.execute("""
+                    insert into TestTempTable (IntCol, StringCol)
+                    values (1, 'test')""")
+            condition.wait(10)
+        cursor.execute("select rowid from TestTempTable where IntCol = 1")
+        rowid, = cursor.fetchone()
+
+        # close the connection and then access the rows
+        connection.unsubscribe(sub)
+        cursor.close()
+        connection.close()
+        table, = tables
+        row, = table.rows
+        self.assertEqual(row.operation, cx_Oracle.OPCODE_INSERT)
+        self.assertEqual(row.rowid, rowid)
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 
@@ -11,7 +11,9 @@
 
 import TestEnv
 
+import array
 import cx_Oracle
+import datetime
 import time
 
 class TestCase(TestEnv.BaseTestCase):
@@ -52,6 +54,41 @@ class TestCase(TestEnv.BaseTestCase):
                 value = cx_Oracle.Timestamp(2002, 12, 14, 0, 0, 10, 250000))
         self.assertEqual(self.cursor.fetchall(), [self.dataByKey[5]])
 
+    def testBindEpoch(self):
+        "test binding integers containing the time elapsed since the epoch"
+        epoch = datetime.datetime(1970, 1, 1)
+        values = [datetime.datetime(2019, 3, 10, 8, 15, 30, 250000),
+                datetime.datetime(1969, 12, 31, 23, 59, 59, 500000),
+                datetime.datetime(2000, 2, 29)]
+        epochValues = array.array("q",
+                [(v - epoch) // datetime.timedelta(milliseconds=1) \
+                for v in values])
+        intVar = self.cursor.var(int, arraysize=len(values))
+        intVar.setvalues(0, [101, 102, 103])
+        timestampVar = self.cursor.var(cx_Oracle.EPOCH_MS,
+                arraysize=len(values))
+        timestampVar.setvalues(0, epochValues)
+        self.cursor.setinputsizes(intVar, timestampVar)
+        self.cursor.executemany("""
+                insert into TestTimestamps (IntCol, TimestampCol)
+                values (:1, :2)""", len(values))
+        self.cursor.execute("""
+                select TimestampCol
+                from TestTimestamps
+                where IntCol > 100
+                order by IntCol""")
+        self.assertEqual([v for v, in self.cursor], values)
+        self.cursor.setinputsizes(value=cx_Oracle.EPOCH_MS)
+        self.cursor.execute("""
+                select IntCol
+                from TestTimestamps
+                where TimestampCol = :value""", value=1039824010250)
+        self.assertEqual(self.cursor.fetchall(), [(5,)])
+        self.assertRaises(cx_Oracle.ProgrammingError, timestampVar.setvalues,
+                0, array.array("i", [1]))
+        self.assertRaises(IndexError, timestampVar.setvalues, 1,
+                epochValues)
+
     def testBindNull(self):
         "test binding in a null"
         self.cursor.setinputsizes(value = cx_Oracle.DB_TYPE_TIMESTAMP)
@@ -118,13 +155,13 @@ class TestCase(TestEnv.BaseTestCase):
 
     def testFetchAll(self):
         "test that fetching all of the data returns the correct results"
-        self.cursor.execute("select * From TestTimestamps order by IntCol")
+        self.cursor.execute("select * from TestTimestamps order by IntCol")
         self.assertEqual(self.cursor.fetchall(), self.rawData)
         self.assertEqual(self.cursor.fetchall(), [])
 
     def testFetchMany(self):
         "test that fetching data in chunks returns the correct results"
-        self.cursor.execute("select * From TestTimestamps order by IntCol")
+        self.cursor.execute("select * from TestTimestamps order by IntCol")
         self.assertEqual(self.cursor.fetchmany(3), self.rawData[0:3])
         self.assertEqual(self.cursor.fetchmany(2), self.rawData[3:5])
         self.assertEqual(self.cursor.fetchmany(4), self.rawData[5:9])
@@ -142,6 +179,77 @@ class TestCase(TestEnv.BaseTestCase):
         self.assertEqual(self.cursor.fetchone(), self.dataByKey[4])
         self.assertEqual(self.cursor.fetchone(), None)
 
+    def testFetchAwareDatetime(self):
+        "test fetching timestamps with time zone as aware datetimes"
+        def handler(cursor, name, defaultType, size, precision, scale):
+            if defaultType == cx_Oracle.DB_TYPE_TIMESTAMP_TZ:
+                return cursor.var(cx_Oracle.DATETIME_TZ,
+                        arraysize=cursor.arraysize)
+        self.cursor.outputtypehandler = handler
+        self.cursor.execute("""
+                select
+                    to_timestamp_tz('20190310 08:15:30.25 -05:00',
+                            'YYYYMMDD HH24:MI:SS.FF TZH:TZM'),
+                    to_timestamp_tz('20190311 23:00:00 -05:00',
+                            'YYYYMMDD HH24:MI:SS TZH:TZM'),
+                    to_timestamp_tz('20190310 18:45:00 +05:30',
+                            'YYYYMMDD HH24:MI:SS TZH:TZM'),
+                    cast(null as timestamp with time zone)
+                from dual""")
+        value1, value2, value3, value4 = self.cursor.fetchone()
+        tz = datetime.timezone(datetime.timedelta(hours=-5))
+        self.assertEqual(value1,
+                datetime.datetime(2019, 3, 10, 8, 15, 30, 250000, tz))
+        self.assertEqual(value1.utcoffset(), datetime.timedelta(hours=-5))
+        self.assertTrue(value1.tzinfo is value2.tzinfo)
+        self.assertEqual(value3.utcoffset(),
+                datetime.timedelta(hours=5, minutes=30))
+        self.assertEqual(value4, None)
+        var = self.cursor.var(cx_Oracle.DATETIME_TZ)
+        var.setvalue(0, value3)
+        self.cursor.execute("select to_char(:1, 'HH24:MI TZH:TZM') from dual",
+                [var])
+        self.assertEqual(self.cursor.fetchone(), ("18:45 +05:30",))
+
+    def testFetchEpoch(self):
+        "test fetching timestamps as the time elapsed since the epoch"
+        epoch = datetime.datetime(1970, 1, 1)
+        expectedData = [(i, (d - epoch) // datetime.timedelta(microseconds=1),
+                None if n is None else \
+                (n - epoch) // datetime.timedelta(microseconds=1)) \
+                for i, d, n in self.rawData]
+        self.cursor.epochunit = "us"
+        self.assertEqual(self.cursor.epochunit, "us")
+        self.cursor.execute("select * from TestTimestamps order by IntCol")
+        self.assertEqual(self.cursor.fetchall(), expectedData)
+        self.cursor.epochunit = "s"
+        self.cursor.execute("""
+                select TimestampCol, trunc(TimestampCol)
+                from TestTimestamps
+                where IntCol = 1""")
+        value, truncValue = self.cursor.fetchone()
+        self.assertEqual(value, expectedData[0][1] // 1000000)
+        self.assertEqual(truncValue, value - value % 86400)
+        self.cursor.execute("""
+                select from_tz(TimestampCol, '+02:00')
+                from TestTimestamps
+                where IntCol = 1""")
+        self.assertEqual(self.cursor.fetchone(), (value - 7200,))
+        self.cursor.epochunit = None
+        def handler(cursor, name, defaultType, size, precision, scale):
+            if defaultType == cx_Oracle.DB_TYPE_TIMESTAMP:
+                return cursor.var(cx_Oracle.EPOCH_NS,
+                        arraysize=cursor.arraysize)
+        self.cursor.outputtypehandler = handler
+        self.cursor.execute("""
+                select TimestampCol
+                from TestTimestamps
+                where IntCol = 1""")
+        self.assertEqual(self.cursor.fetchone(),
+                (expectedData[0][1] * 1000,))
+        self.assertRaises(cx_Oracle.ProgrammingError, setattr, self.cursor,
+                "epochunit", "days")
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 